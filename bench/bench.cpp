@@ -0,0 +1,461 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+#include <thread>
+#include <cstdlib>
+#include <limits>
+#include <concepts>
+#include "HardyZ.h"
+#include "Zeros.h"
+#include "Plotter.h"
+#include "DeltaFrames.h"
+
+// Speed and accuracy suite: `make bench` writes output/bench.json and exits non-zero if an
+// accuracy check fails, so two runs (e.g. two releases) can be diffed for regressions.
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // Ordinates of known zeros of zeta(1/2 + it) and the precision of the tabulated digits
+    struct KnownZero {
+        int index;
+        double t;
+        double digits_error;
+    };
+
+    constexpr KnownZero KNOWN_ZEROS[] = {
+        {       1, 14.134725141734693790, 1e-15 },
+        {       2, 21.022039638771554993, 1e-15 },
+        {       3, 25.010857580145688763, 1e-15 },
+        {       4, 30.424876125859513210, 1e-15 },
+        {       5, 32.935061587739189691, 1e-15 },
+        {       6, 37.586178158825671257, 1e-15 },
+        {       7, 40.918719012147495187, 1e-15 },
+        {       8, 43.327073280914999519, 1e-15 },
+        {       9, 48.005150881167159727, 1e-15 },
+        {      10, 49.773832477672302181, 1e-15 },
+        {     100, 236.52422966581620580, 1e-14 },
+        {    1000, 1419.4224809459956865, 1e-13 },
+        {   10000, 9877.7826540055011428, 1e-12 },
+        {  100000, 74920.827498994,       1e-9 },
+        { 1000000, 600269.677012450,      1e-9 },
+    };
+
+    // Hand-rolled JSON: one flat object per measurement
+    class Report {
+    public:
+        Report& begin(const std::string& suite) {
+            records.emplace_back("\"suite\": \"" + suite + "\"");
+            return *this;
+        }
+        Report& field(const std::string& key, const std::string& value) {
+            records.back() += ", \"" + key + "\": \"" + value + "\"";
+            return *this;
+        }
+        Report& field(const std::string& key, double value) {
+            std::ostringstream ss;
+            if (std::isfinite(value)) ss << std::setprecision(6) << value; else ss << "null";
+            records.back() += ", \"" + key + "\": " + ss.str();
+            return *this;
+        }
+        Report& check(bool pass) {
+            records.back() += std::string(", \"pass\": ") + (pass ? "true" : "false");
+            if (!pass) ++failures;
+            return *this;
+        }
+
+        int failed() const { return failures; }
+
+        bool write(const std::string& path) const {
+            std::ofstream file(path);
+            if (!file) { std::cerr << "Error opening " << path << std::endl; return false; }
+            file << "[\n";
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                file << "  {" << records[i] << "}" << (i + 1 < records.size() ? ",\n" : "\n");
+            }
+            file << "]\n";
+            return true;
+        }
+
+    private:
+        std::vector<std::string> records;
+        int failures = 0;
+    };
+
+    // Seconds per call of f, repeating until `budget` seconds have elapsed
+    template <typename F>
+    double time_per_call(F&& f, double budget = 0.05) {
+        f(); // warm caches and tables
+        long long reps = 1;
+        while (true) {
+            const auto start = Clock::now();
+            for (long long i = 0; i < reps; ++i) f();
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (elapsed >= budget || reps >= (1LL << 30)) return elapsed / static_cast<double>(reps);
+            reps *= (elapsed > budget / 16) ? 2 : 8;
+        }
+    }
+
+    volatile double sink_value = 0.0;
+
+    const char* method_name(Zeta::Method method) {
+        switch (method) {
+            case Zeta::Method::EulerMaclaurin:         return "EulerMaclaurin";
+            case Zeta::Method::RiemannSiegel:          return "RiemannSiegel";
+            case Zeta::Method::RiemannSiegelRemainder: return "RiemannSiegelRemainder";
+            case Zeta::Method::OdlyzkoSchonhage:       return "OdlyzkoSchonhage";
+        }
+        return "?";
+    }
+
+    template <std::floating_point T> const char* type_name();
+    template <> const char* type_name<float>() { return "float"; }
+    template <> const char* type_name<double>() { return "double"; }
+    template <> const char* type_name<long double>() { return "long double"; }
+
+    // Terms in the dominant sum for one evaluation at t
+    template <std::floating_point T>
+    double terms(Zeta::Method method, double t) {
+        if (method == Zeta::Method::EulerMaclaurin) {
+            const auto params = Zeta::Hardy::detail::chooseEM(std::complex<T>(T{0.5}, static_cast<T>(t)),
+                                                              Zeta::Options{}.em_tolerance);
+            return params.N + params.m;
+        }
+        return std::floor(std::sqrt(t / (2.0 * std::numbers::pi)));
+    }
+
+    // Most accurate value available: long double EM where affordable, long double RS + C0..C4 above
+    long double reference_z(long double t) {
+        Zeta::Options options;
+        options.em_tolerance = 1e-18;
+        if (t <= 1e4L) return Zeta::Hardy::compute<long double>(t, Zeta::Method::EulerMaclaurin, options);
+        return Zeta::Hardy::compute<long double>(t, Zeta::Method::RiemannSiegelRemainder, options);
+    }
+
+    // Heights sampled per decade for the error columns
+    std::vector<double> heights_in_decade(double decade) {
+        return { decade, decade * 1.37, decade * 2.71, decade * 5.03, decade * 8.59 };
+    }
+
+    // ---------------------------------------------------------------
+    // Point evaluation: evaluations/s, ns/term, max error per decade
+    // ---------------------------------------------------------------
+
+    template <std::floating_point T>
+    void bench_points(Report& report) {
+        const Zeta::Method methods[] = {
+            Zeta::Method::EulerMaclaurin, Zeta::Method::RiemannSiegel, Zeta::Method::RiemannSiegelRemainder
+        };
+
+        for (Zeta::Method method : methods) {
+            for (int e = 2; e <= 10; ++e) {
+                const double t = std::pow(10.0, e);
+                if (method == Zeta::Method::EulerMaclaurin && e > 6) continue; // O(t): minutes per call
+
+                const T t_T = static_cast<T>(t);
+                const double seconds = time_per_call([t_T, method] {
+                    sink_value = sink_value + static_cast<double>(Zeta::Hardy::compute<T>(t_T, method));
+                });
+
+                // Above 1e4 the long double remainder series is the reference itself
+                const bool is_reference = std::same_as<T, long double>
+                    && method == Zeta::Method::RiemannSiegelRemainder && t > 1e4;
+
+                double max_error = is_reference ? std::numeric_limits<double>::quiet_NaN() : 0.0;
+                for (double h : is_reference ? std::vector<double>{} : heights_in_decade(t)) {
+                    if (method == Zeta::Method::EulerMaclaurin && h > 2e6) continue;
+                    const long double ref = reference_z(static_cast<long double>(static_cast<T>(h)));
+                    const long double z = Zeta::Hardy::compute<T>(static_cast<T>(h), method);
+                    max_error = std::max(max_error, static_cast<double>(std::abs(z - ref)));
+                }
+
+                report.begin("point")
+                    .field("type", type_name<T>())
+                    .field("method", method_name(method))
+                    .field("t", t)
+                    .field("evals_per_s", 1.0 / seconds)
+                    .field("ns_per_term", seconds * 1e9 / std::max(terms<T>(method, t), 1.0))
+                    .field("max_abs_error", max_error);
+
+                std::cout << std::setw(12) << type_name<T>() << std::setw(24) << method_name(method)
+                          << "  t=1e" << std::setw(2) << std::left << e << std::right
+                          << std::setw(14) << std::setprecision(4) << 1.0 / seconds << " eval/s"
+                          << std::setw(12) << seconds * 1e9 / std::max(terms<T>(method, t), 1.0) << " ns/term"
+                          << std::setw(12) << max_error << " err" << std::endl;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // Block throughput against point count and thread count
+    // ---------------------------------------------------------------
+
+    void bench_blocks(Report& report) {
+        struct Case { Zeta::Method method; double t; };
+        const Case cases[] = {
+            { Zeta::Method::EulerMaclaurin, 1e4 },
+            { Zeta::Method::RiemannSiegel, 1e6 },
+            { Zeta::Method::RiemannSiegelRemainder, 1e6 },
+            { Zeta::Method::OdlyzkoSchonhage, 1e8 },
+        };
+
+        std::vector<int> thread_counts = { 1, 2, 4, Zeta::Parallel::resolveThreads(0) };
+        std::ranges::sort(thread_counts);
+        const auto [last, end] = std::ranges::unique(thread_counts);
+        thread_counts.erase(last, end);
+
+        for (const Case& c : cases) {
+            for (int points : { 1000, 10000, 100000 }) {
+                for (int threads : thread_counts) {
+                    Zeta::Options options;
+                    options.threads = threads;
+                    const double length = 0.01 * (points - 1); // dense scan spacing
+                    const double seconds = time_per_call([&] {
+                        auto values = Zeta::Hardy::computeBlock<double>(c.t, length, points, c.method, options);
+                        sink_value = sink_value + values.back();
+                    }, 0.2);
+
+                    report.begin("block")
+                        .field("method", method_name(c.method))
+                        .field("t", c.t)
+                        .field("points", points)
+                        .field("threads", threads)
+                        .field("points_per_s", points / seconds);
+
+                    std::cout << std::setw(24) << method_name(c.method) << "  t=" << std::setw(6) << c.t
+                              << std::setw(8) << points << " pts" << std::setw(4) << threads << " thr"
+                              << std::setw(14) << std::setprecision(4) << points / seconds << " pts/s" << std::endl;
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // Accuracy: known zeros, and OS against the pointwise main sum
+    // ---------------------------------------------------------------
+
+    template <std::floating_point T>
+    void check_zeros(Report& report, Zeta::Method method) {
+        Zeta::Zeros::ScanOptions options;
+        options.method = method;
+        options.options.em_tolerance = 1e-14;
+        options.tolerance = 1e-13;
+
+        for (const KnownZero& zero : KNOWN_ZEROS) {
+            if (method == Zeta::Method::EulerMaclaurin && zero.t > 1e5) continue;
+
+            const T lo = static_cast<T>(zero.t - 0.02);
+            const T hi = static_cast<T>(zero.t + 0.02);
+            const auto found = Zeta::Zeros::refine<T>({
+                lo, hi,
+                Zeta::Hardy::compute<T>(lo, method, options.options),
+                Zeta::Hardy::compute<T>(hi, method, options.options)
+            }, options);
+            const double error = std::abs(static_cast<double>(found.t) - zero.t);
+
+            // The remainder series is asymptotic: allow its O(t^{-11/4}) error at the lowest zeros
+            double allowed = std::max(zero.digits_error, 1e-9 * std::max(1.0, zero.t / 1e4));
+            if (method == Zeta::Method::RiemannSiegelRemainder && zero.t < 200) allowed = 1e-5;
+
+            report.begin("zero")
+                .field("type", type_name<T>())
+                .field("method", method_name(method))
+                .field("index", zero.index)
+                .field("t", zero.t)
+                .field("abs_error", error)
+                .field("allowed", allowed)
+                .check(error <= allowed);
+
+            if (error > allowed) {
+                std::cout << "FAIL zero #" << zero.index << " " << type_name<T>() << " " << method_name(method)
+                          << ": error " << error << " > " << allowed << std::endl;
+            }
+        }
+    }
+
+    void check_os(Report& report) {
+        for (double t : { 1e4, 1e6, 1e8 }) {
+            const int points = 2000;
+            const double step = 0.01;
+            const auto block = Zeta::Hardy::computeBlock<double>(t, step * (points - 1), points,
+                                                                 Zeta::Method::OdlyzkoSchonhage);
+            double max_error = 0.0;
+            for (int k = 0; k < points; k += 7) {
+                const double z = Zeta::Hardy::compute<double>(t + k * step, Zeta::Method::RiemannSiegel);
+                max_error = std::max(max_error, std::abs(block[k] - z));
+            }
+            report.begin("os_vs_rs").field("t", t).field("max_abs_error", max_error).check(max_error < 1e-6);
+            std::cout << "OS vs RS main sum at t=" << t << ": " << max_error << std::endl;
+        }
+    }
+
+    // Odlyzko-Schonhage scans refine pointwise with the remainder: same zeros as a
+    // Riemann-Siegel-remainder scan, and Turing's method still terminates and confirms
+    void check_scan_os(Report& report) {
+        for (double t : { 1e4, 1e6, 1e8 }) {
+            auto zeros = [t](Zeta::Method method) {
+                Zeta::Zeros::ScanOptions options;
+                options.method = method;
+                std::vector<double> found;
+                Zeta::Zeros::scan<double>(t, t + 20.0, [&found](const auto& z) { found.push_back(z.t); }, options);
+                return found;
+            };
+            const std::vector<double> os = zeros(Zeta::Method::OdlyzkoSchonhage);
+            const std::vector<double> rsr = zeros(Zeta::Method::RiemannSiegelRemainder);
+
+            double max_error = (os.size() == rsr.size() && !os.empty()) ? 0.0 : INFINITY;
+            for (std::size_t i = 0; i < os.size() && i < rsr.size(); ++i) max_error = std::max(max_error, std::abs(os[i] - rsr[i]));
+            report.begin("scan_os_vs_rsr").field("t", t).field("zeros", static_cast<double>(os.size()))
+                .field("max_abs_error", max_error).check(max_error < 1e-8);
+            std::cout << "OS vs RSR scan zeros at t=" << t << ": " << os.size() << " zeros, " << max_error << std::endl;
+        }
+
+        Zeta::Zeros::ScanOptions options;
+        options.method = Zeta::Method::OdlyzkoSchonhage;
+        const auto count = Zeta::Zeros::verifyCount<double>(1000.0, 1010.0, options);
+        report.begin("turing_os").field("found", static_cast<double>(count.found)).check(count.confirmed);
+        std::cout << "Turing count with OS on [1000, 1010]: " << count.found << (count.confirmed ? " confirmed" : " NOT confirmed") << std::endl;
+    }
+
+    // Z(0) = zeta(1/2) on every path: pointwise, and as an interior point of a block
+    void check_t_zero(Report& report) {
+        constexpr double ZETA_HALF = -1.4603545088095868;
+        double max_error = 0.0;
+        for (Zeta::Method method : { Zeta::Method::EulerMaclaurin, Zeta::Method::RiemannSiegel,
+                                     Zeta::Method::RiemannSiegelRemainder, Zeta::Method::OdlyzkoSchonhage }) {
+            if (method != Zeta::Method::OdlyzkoSchonhage) {
+                max_error = std::max(max_error, std::abs(Zeta::Hardy::compute<double>(0.0, method) - ZETA_HALF));
+            }
+            const std::vector<double> block = Zeta::Hardy::computeBlock<double>(-1.0, 2.0, 65, method);
+            max_error = std::max(max_error, std::abs(block[32] - ZETA_HALF));
+        }
+        report.begin("t_zero").field("max_abs_error", max_error).check(max_error == 0.0);
+        std::cout << "Z(0) on every path: max error " << max_error << std::endl;
+    }
+
+    // Adaptive scans bracket the close pairs a uniform grid of the same density steps over:
+    // all zeros of a 32-per-gap reference scan, at the same positions
+    void check_scan_adaptive(Report& report) {
+        for (double t : { 1e4, 1e6, 1e8 }) {
+            auto zeros = [t](Zeta::Zeros::Sampling sampling, int samples_per_gap, long long& evaluations) {
+                Zeta::Zeros::ScanOptions options;
+                options.sampling = sampling;
+                options.samples_per_gap = samples_per_gap;
+                std::vector<double> found;
+                evaluations = Zeta::Zeros::scan<double>(t, t + 100.0, [&found](const auto& z) { found.push_back(z.t); }, options).evaluations;
+                return found;
+            };
+            long long uniform_evaluations = 0, adaptive_evaluations = 0, reference_evaluations = 0;
+            const std::vector<double> uniform = zeros(Zeta::Zeros::Sampling::Uniform, 4, uniform_evaluations);
+            const std::vector<double> adaptive = zeros(Zeta::Zeros::Sampling::Adaptive, 4, adaptive_evaluations);
+            const std::vector<double> reference = zeros(Zeta::Zeros::Sampling::Uniform, 32, reference_evaluations);
+
+            double max_error = (adaptive.size() == reference.size()) ? 0.0 : INFINITY;
+            for (std::size_t i = 0; i < adaptive.size() && i < reference.size(); ++i) max_error = std::max(max_error, std::abs(adaptive[i] - reference[i]));
+            report.begin("scan_adaptive").field("t", t)
+                .field("zeros", static_cast<double>(reference.size()))
+                .field("uniform_zeros", static_cast<double>(uniform.size()))
+                .field("adaptive_zeros", static_cast<double>(adaptive.size()))
+                .field("uniform_evaluations", static_cast<double>(uniform_evaluations))
+                .field("adaptive_evaluations", static_cast<double>(adaptive_evaluations))
+                .field("reference_evaluations", static_cast<double>(reference_evaluations))
+                .field("max_abs_error", max_error)
+                .check(max_error < 1e-8 + 16.0 * std::numeric_limits<double>::epsilon() * t);
+            std::cout << "Scan of [" << t << ", +100]: " << reference.size() << " zeros; uniform " << uniform.size() << " in "
+                      << uniform_evaluations << " evaluations, adaptive " << adaptive.size() << " in " << adaptive_evaluations
+                      << " (reference: " << reference_evaluations << "), max difference " << max_error << std::endl;
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // Plotter: render only, and the render + save paths
+    // ---------------------------------------------------------------
+
+    class NullSink : public FrameSink {
+    public:
+        void write_frame(const unsigned char* rgb, int width, int height, int) override {
+            sink_value = sink_value + rgb[static_cast<std::size_t>(width) * height * 3 / 2];
+        }
+    };
+
+    void bench_plotter(Report& report) {
+        const int frames = 6000;
+        const auto values = Zeta::Hardy::computeBlock<double>(10000.0, 100.0, frames + 1,
+                                                              Zeta::Method::RiemannSiegel);
+        std::vector<double> ts(frames + 1);
+        for (int i = 0; i <= frames; ++i) ts[i] = 10000.0 + 100.0 * i / frames;
+
+        auto run = [&](const std::string& path, FrameSink& sink, int count) {
+            std::streambuf* saved = std::cout.rdbuf(nullptr); // silence the progress line
+            const auto start = Clock::now();
+            PlotCanvas(600, 300).fill_background(Color(0, 0, 0))
+                .animate_function(sink, std::span(ts).first(count + 1), std::span(values).first(count + 1),
+                                  Color(170, 220, 255), Color(255, 215, 0));
+            sink.finish();
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            std::cout.rdbuf(saved);
+
+            report.begin("plotter").field("path", path).field("frames", count).field("frames_per_s", count / seconds);
+            std::cout << std::setw(12) << path << std::setw(8) << count << " frames"
+                      << std::setw(14) << std::setprecision(4) << count / seconds << " frames/s" << std::endl;
+        };
+
+        NullSink null_sink;
+        run("render", null_sink, frames);
+
+        std::system("mkdir -p output/bench_frames");
+        PpmFileSink ppm("output/bench_frames");
+        run("ppm", ppm, 300);
+        std::system("rm -rf output/bench_frames");
+
+        DeltaFileSink delta("output/bench.pdl", 300);
+        run("delta", delta, frames);
+
+        AsyncSink async_delta(std::make_unique<DeltaFileSink>("output/bench.pdl", 300));
+        run("async_delta", async_delta, frames);
+        std::remove("output/bench.pdl");
+
+        auto y4m = StreamSink::to_file("/dev/null", StreamSink::Format::Y4M, 300);
+        run("y4m", *y4m, 1000);
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const std::string path = (argc > 1) ? argv[1] : "output/bench.json";
+    std::system("mkdir -p output");
+    Report report;
+
+    std::cout << "== Point evaluation ==" << std::endl;
+    bench_points<float>(report);
+    bench_points<double>(report);
+    bench_points<long double>(report);
+
+    std::cout << "== Block throughput ==" << std::endl;
+    bench_blocks(report);
+
+    std::cout << "== Accuracy ==" << std::endl;
+    check_zeros<double>(report, Zeta::Method::EulerMaclaurin);
+    check_zeros<double>(report, Zeta::Method::RiemannSiegelRemainder);
+    check_zeros<long double>(report, Zeta::Method::EulerMaclaurin);
+    check_zeros<long double>(report, Zeta::Method::RiemannSiegelRemainder);
+    check_os(report);
+    check_scan_os(report);
+    check_scan_adaptive(report);
+    check_t_zero(report);
+
+    std::cout << "== Plotter ==" << std::endl;
+    bench_plotter(report);
+
+    if (!report.write(path)) return 1;
+    std::cout << "Results: " << path << " (" << report.failed() << " failed checks)" << std::endl;
+    return report.failed() == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <concepts>
+#include "HardyZ.h"
+#include "SampleCache.h"
+
+namespace Zeta::Hardy {
+
+    /**
+     * @brief Settings of sampleAdaptive.
+     */
+    struct AdaptiveOptions {
+        /**
+         * @brief The curve whose linear interpolation must meet the tolerance.
+         */
+        enum class Curve {
+            Hardy, ///< $ Z(t) $, as drawn by PlotCanvas::animate_function
+            Zeta   ///< $ \zeta(\frac{1}{2} + it) = Z(t) e^{-i\theta(t)} $ in the complex plane, as drawn by animate_complex_zeta
+        };
+
+        Method method = Method::RiemannSiegelRemainder;
+        Options options = {};
+        Curve curve = Curve::Hardy;
+
+        /**
+         * @brief Largest accepted distance between the curve and its polyline, in units of $ Z $.
+         * For a plot, half a pixel: (y range) / (2 * height).
+         */
+        double tolerance = 0.02;
+
+        /**
+         * @brief Points of the initial uniform grid per mean zero spacing $ 2\pi / \ln(t/2\pi) $.
+         */
+        int samples_per_gap = 4;
+
+        /**
+         * @brief Cap on evaluations of $ Z $, the initial grid included.
+         */
+        int max_evaluations = 1 << 20;
+
+        /**
+         * @brief Intervals this short are never split (0: $ 2^{-24} $ of the range).
+         */
+        double min_step = 0.0;
+
+        /**
+         * @brief Midpoints evaluated per refinement round, in parallel on Options::threads workers.
+         */
+        int batch = 256;
+    };
+
+    /**
+     * @brief Samples $ Z $ on $ [t_0, t_1] $ densely where it bends and sparsely where it is straight.
+     * * A uniform grid (AdaptiveOptions::samples_per_gap) is evaluated with computeBlock.
+     * * Every interval gets an error estimate from the second divided differences of its neighbourhood,
+     *   $ |f''| h^2 / 8 $ for the polyline. For Curve::Hardy, an interval whose end values share a sign
+     *   but whose local parabola crosses zero (a zero pair the grid stepped over) is always split.
+     * * The worst intervals are bisected in rounds, each midpoint evaluated with Hardy::compute,
+     *   until every estimate meets the tolerance or the evaluation cap is reached.
+     * * Method::OdlyzkoSchonhage has no pointwise form: its grid is completed with the remainder and the
+     *   midpoints use detail::pointwiseMethod, so both are the Riemann-Siegel sum with remainder.
+     * @return Increasing $ t $ with $ Z(t) $ and $ \theta(t) $; both ends are included.
+     */
+    template <std::floating_point T>
+    [[nodiscard]]
+    Samples<T> sampleAdaptive(T start_t, T end_t, const AdaptiveOptions& options = {});
+
+}
+
+#include "Adaptive.tpp"
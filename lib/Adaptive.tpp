@@ -0,0 +1,191 @@
+#include "Theta.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <queue>
+#include <vector>
+#include <algorithm>
+
+namespace Zeta::Hardy {
+
+    namespace detail {
+
+        /**
+         * @brief One sample of sampleAdaptive, linked to its neighbours in increasing t.
+         */
+        template <std::floating_point T>
+        struct AdaptiveNode {
+            T t;
+            T z;
+            T theta;
+            int prev;
+            int next;
+            unsigned version = 0; ///< Bumped whenever the interval starting here is re-estimated
+        };
+
+        /**
+         * @brief Error estimate of the interval [nodes[a], nodes[a].next] (see sampleAdaptive).
+         */
+        template <std::floating_point T>
+        double adaptiveError(const std::vector<AdaptiveNode<T>>& nodes, int a, const AdaptiveOptions& options,
+                             double min_step) {
+            const AdaptiveNode<T>& left = nodes[a];
+            const AdaptiveNode<T>& right = nodes[left.next];
+            const double h = static_cast<double>(right.t - left.t);
+            if (h <= min_step) return 0.0;
+
+            const bool hardy = options.curve == AdaptiveOptions::Curve::Hardy;
+            auto value = [hardy](const AdaptiveNode<T>& n) {
+                return hardy ? std::complex<double>(static_cast<double>(n.z), 0.0)
+                             : std::polar(static_cast<double>(n.z), -static_cast<double>(n.theta));
+            };
+
+            // Second divided difference [p, q, r] = f''/2 on a parabola
+            auto divided = [&](const AdaptiveNode<T>& p, const AdaptiveNode<T>& q, const AdaptiveNode<T>& r) {
+                const double pq = static_cast<double>(q.t - p.t);
+                const double qr = static_cast<double>(r.t - q.t);
+                return ((value(r) - value(q)) / qr - (value(q) - value(p)) / pq) / (pq + qr);
+            };
+
+            double curvature = 0.0;
+            bool hidden_zeros = false;
+            auto consider = [&](const AdaptiveNode<T>& p, const AdaptiveNode<T>& q, const AdaptiveNode<T>& r) {
+                const std::complex<double> d2 = divided(p, q, r);
+                curvature = std::max(curvature, std::abs(d2));
+                if (!hardy || (left.z > T{0}) != (right.z > T{0})) return;
+
+                // Vertex of the parabola f_q + [q, r] u + c u (u - w), u = t - t_q, w = t_r - t_q;
+                // a sign flip there inside [left, right] hides a zero pair
+                const double c = d2.real();
+                if (c == 0.0) return;
+                const double w = static_cast<double>(r.t - q.t);
+                const double qr = static_cast<double>(r.z - q.z) / w;
+                const double u = w / 2.0 - qr / (2.0 * c);
+                const double vertex = static_cast<double>(q.t) + u;
+                if (vertex <= static_cast<double>(left.t) || vertex >= static_cast<double>(right.t)) return;
+                const double extremum = static_cast<double>(q.z) + qr * u + c * u * (u - w);
+                hidden_zeros = hidden_zeros || ((extremum > 0.0) != (left.z > T{0}));
+            };
+
+            if (left.prev >= 0) consider(nodes[left.prev], left, right);
+            if (right.next >= 0) consider(left, right, nodes[right.next]);
+
+            if (hidden_zeros) return std::numeric_limits<double>::infinity();
+            return curvature * h * h / 4.0;
+        }
+
+    }
+
+    template <std::floating_point T>
+    Samples<T> sampleAdaptive(T start_t, T end_t, const AdaptiveOptions& options) {
+        Samples<T> result;
+        if (!(end_t > start_t)) return result;
+
+        const T length = end_t - start_t;
+        const double min_step = (options.min_step > 0.0) ? options.min_step : static_cast<double>(length) * 0x1p-24;
+        const T gap = Zeta::meanGap<T>(std::max(std::abs(start_t), std::abs(end_t)));
+        const int cap = std::max(options.max_evaluations, 3);
+        const int initial = static_cast<int>(std::clamp<double>(
+            std::ceil(static_cast<double>(length / gap) * std::max(options.samples_per_gap, 1)) + 1.0, 3.0, cap));
+
+        // Initial uniform grid, as one block
+        std::vector<detail::AdaptiveNode<T>> nodes(initial);
+        {
+            std::vector<T> z = computeBlock<T>(start_t, length, initial, options.method, options.options);
+            const T step = length / static_cast<T>(initial - 1);
+            if (options.method == Method::OdlyzkoSchonhage) detail::addRemainderRS<T>(start_t, step, z, options.options.rs_order);
+            std::vector<T> theta(initial);
+            Zeta::thetaGrid<T>(start_t, step, theta);
+            for (int k = 0; k < initial; ++k) {
+                nodes[k] = { start_t + static_cast<T>(k) * step, z[k], theta[k], k - 1, (k + 1 < initial) ? k + 1 : -1 };
+            }
+            nodes.back().t = end_t;
+        }
+
+        struct Candidate {
+            double error;
+            int node;
+            unsigned version;
+
+            bool operator<(const Candidate& other) const { return error < other.error; }
+        };
+        std::priority_queue<Candidate> queue;
+
+        auto estimate = [&](int a) {
+            if (a < 0 || nodes[a].next < 0) return;
+            const unsigned version = ++nodes[a].version;
+            const double error = detail::adaptiveError(nodes, a, options, min_step);
+            if (error > options.tolerance) queue.push({ error, a, version });
+        };
+        for (int a = 0; a + 1 < initial; ++a) estimate(a);
+
+        // Midpoints go through the pointwise evaluator, which for Odlyzko-Schonhage includes the remainder
+        const Method pointwise = detail::pointwiseMethod(options.method);
+        const int threads = Parallel::availableThreads(options.options.pool, options.options.threads);
+        int evaluations = initial;
+        std::vector<int> split;
+        std::vector<T> mid_t, mid_z;
+
+        while (!queue.empty() && evaluations < cap) {
+            // The worst current intervals, up to one batch and the remaining budget
+            const int room = std::min(std::max(options.batch, 1), cap - evaluations);
+            split.clear();
+            while (!queue.empty() && static_cast<int>(split.size()) < room) {
+                const Candidate top = queue.top();
+                queue.pop();
+                if (top.version == nodes[top.node].version) split.push_back(top.node);
+            }
+            if (split.empty()) break;
+
+            const int count = static_cast<int>(split.size());
+            mid_t.resize(count);
+            mid_z.resize(count);
+            for (int i = 0; i < count; ++i) {
+                const int a = split[i];
+                mid_t[i] = nodes[a].t + (nodes[nodes[a].next].t - nodes[a].t) / T{2};
+            }
+
+            auto evaluate = [&](int i) { mid_z[i] = compute<T>(mid_t[i], pointwise, options.options); };
+            // One pool of the full budget for every round; rounds with fewer chunks leave workers idle
+            const int chunks = (count + 15) / 16;
+            if (threads <= 1 || chunks <= 1) {
+                for (int i = 0; i < count; ++i) evaluate(i);
+            } else {
+                Parallel::selectPool(options.options.pool, threads).parallelFor(chunks, [&](int chunk, int) {
+                    for (int i = chunk * 16; i < std::min(count, chunk * 16 + 16); ++i) evaluate(i);
+                });
+            }
+            evaluations += count;
+
+            // Link the midpoints in, then re-estimate every interval whose neighbourhood changed
+            for (int i = 0; i < count; ++i) {
+                const int a = split[i];
+                const int b = nodes[a].next;
+                const int m = static_cast<int>(nodes.size());
+                nodes.push_back({ mid_t[i], mid_z[i], Zeta::theta<T>(mid_t[i]), a, b });
+                nodes[a].next = m;
+                nodes[b].prev = m;
+            }
+            for (int i = 0; i < count; ++i) {
+                const int a = split[i];
+                const int m = nodes[a].next;
+                estimate(nodes[a].prev);
+                estimate(a);
+                estimate(m);
+                estimate(nodes[m].next);
+            }
+        }
+
+        result.t.reserve(nodes.size());
+        result.z.reserve(nodes.size());
+        result.theta.reserve(nodes.size());
+        for (int a = 0; a >= 0; a = nodes[a].next) {
+            result.t.push_back(nodes[a].t);
+            result.z.push_back(nodes[a].z);
+            result.theta.push_back(nodes[a].theta);
+        }
+        return result;
+    }
+
+}
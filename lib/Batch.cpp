@@ -0,0 +1,440 @@
+#include "Batch.h"
+#include "Adaptive.h"
+#include "ZetaPlane.h"
+#include "Plotter.h"
+#include "FrameSink.h"
+#include "DeltaFrames.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <thread>
+
+namespace {
+
+    // Blocking FIFO between two pipeline stages. push waits while `capacity` items are queued;
+    // pop waits for an item and returns nothing once the queue is closed and drained.
+    template <typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(int capacity) : capacity(static_cast<std::size_t>(std::max(capacity, 1))) {}
+
+        void push(T item) {
+            std::unique_lock lock(mutex);
+            not_full.wait(lock, [this] { return items.size() < capacity; });
+            items.push_back(std::move(item));
+            lock.unlock();
+            not_empty.notify_one();
+        }
+
+        std::optional<T> pop() {
+            std::unique_lock lock(mutex);
+            not_empty.wait(lock, [this] { return !items.empty() || closed; });
+            if (items.empty()) return std::nullopt;
+            T item = std::move(items.front());
+            items.pop_front();
+            lock.unlock();
+            not_full.notify_one();
+            return item;
+        }
+
+        void close() {
+            {
+                std::lock_guard lock(mutex);
+                closed = true;
+            }
+            not_empty.notify_all();
+        }
+
+    private:
+        std::size_t capacity;
+        std::deque<T> items;
+        bool closed = false;
+        std::mutex mutex;
+        std::condition_variable not_full;
+        std::condition_variable not_empty;
+    };
+
+    // Output of the sampling stage: what the rasterizer needs for one job
+    struct SampledJob {
+        const JobSpec* job = nullptr;
+        std::vector<double> t, z, theta;         // Kind::Hardy and Kind::Zeta
+        std::vector<std::complex<double>> plane; // Kind::Plane, width x height row-major
+        double seconds = 0.0;
+    };
+
+    const Color BLACK(0, 0, 0);
+    const Color GRAY(100, 100, 100);
+    const Color BLUE(170, 220, 255);
+    const Color GOLD(255, 215, 0);
+
+    // Plot ranges fixed by PlotCanvas::animate_function (Z in [-6, 6]) and animate_complex_zeta
+    constexpr double HARDY_RANGE = 12.0;
+    constexpr double ZETA_RANGE = 16.0;
+
+    std::string trim(const std::string& text) {
+        const auto first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return {};
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    bool parse_method(const std::string& name, Zeta::Method& method) {
+        if (name == "em") method = Zeta::Method::EulerMaclaurin;
+        else if (name == "rs") method = Zeta::Method::RiemannSiegel;
+        else if (name == "rsr") method = Zeta::Method::RiemannSiegelRemainder;
+        else if (name == "os") method = Zeta::Method::OdlyzkoSchonhage;
+        else return false;
+        return true;
+    }
+
+    bool parse_kind(const std::string& name, JobSpec::Kind& kind) {
+        if (name == "hardy") kind = JobSpec::Kind::Hardy;
+        else if (name == "zeta") kind = JobSpec::Kind::Zeta;
+        else if (name == "plane") kind = JobSpec::Kind::Plane;
+        else return false;
+        return true;
+    }
+
+    bool parse_sink(const std::string& name, JobSpec::Sink& sink) {
+        if (name == "auto") sink = JobSpec::Sink::Auto;
+        else if (name == "ffmpeg") sink = JobSpec::Sink::Ffmpeg;
+        else if (name == "delta") sink = JobSpec::Sink::Delta;
+        else if (name == "y4m") sink = JobSpec::Sink::Y4m;
+        else if (name == "ppm") sink = JobSpec::Sink::Ppm;
+        else if (name == "image") sink = JobSpec::Sink::Image;
+        else return false;
+        return true;
+    }
+
+    // Sets one key of a job; false for unknown keys and bad values (std::stod and std::stoi throw)
+    bool set_job_key(JobSpec& job, const std::string& key, const std::string& value) {
+        if (key == "kind") return parse_kind(value, job.kind);
+        if (key == "method") return parse_method(value, job.method);
+        if (key == "sink") return parse_sink(value, job.sink);
+        if (key == "precision") {
+            job.precision = value;
+            return value == "float" || value == "double" || value == "long";
+        }
+        if (key == "t0") job.t0 = std::stod(value);
+        else if (key == "t1") job.t1 = std::stod(value);
+        else if (key == "sigma0") job.sigma0 = std::stod(value);
+        else if (key == "sigma1") job.sigma1 = std::stod(value);
+        else if (key == "tolerance") job.tolerance = std::stod(value);
+        else if (key == "frames") job.frames = std::stoi(value);
+        else if (key == "width") job.width = std::stoi(value);
+        else if (key == "height") job.height = std::stoi(value);
+        else if (key == "fps") job.fps = std::stoi(value);
+        else return false;
+        return true;
+    }
+
+    bool set_batch_key(BatchSpec& spec, const std::string& key, const std::string& value) {
+        if (key == "output") spec.output = value;
+        else if (key == "threads") spec.threads = std::stoi(value);
+        else if (key == "queue") spec.queue = std::stoi(value);
+        else if (key == "frame_queue") spec.frame_queue = std::stoi(value);
+        else return false;
+        return true;
+    }
+
+    bool have_ffmpeg() {
+        static const bool found = std::system("command -v ffmpeg > /dev/null 2>&1") == 0;
+        return found;
+    }
+
+    JobSpec::Sink resolve_sink(const JobSpec& job) {
+        if (job.kind == JobSpec::Kind::Plane) return JobSpec::Sink::Image;
+        if (job.sink == JobSpec::Sink::Auto) return have_ffmpeg() ? JobSpec::Sink::Ffmpeg : JobSpec::Sink::Delta;
+        return job.sink;
+    }
+
+    std::string output_path(const BatchSpec& spec, const JobSpec& job) {
+        const std::string base = spec.output + "/" + job.name;
+        switch (resolve_sink(job)) {
+            case JobSpec::Sink::Ffmpeg: return base + ".mp4";
+            case JobSpec::Sink::Delta: return base + ".pdl";
+            case JobSpec::Sink::Y4m: return base + ".y4m";
+            case JobSpec::Sink::Ppm: return base;
+            default: return base + ".ppm";
+        }
+    }
+
+    // The frame sink of an animation, behind a writer thread with `depth` buffered frames; null on failure
+    std::unique_ptr<FrameSink> make_sink(const BatchSpec& spec, const JobSpec& job) {
+        const std::string path = output_path(spec, job);
+        std::unique_ptr<FrameSink> target;
+        switch (resolve_sink(job)) {
+            case JobSpec::Sink::Ffmpeg: {
+                auto stream = StreamSink::to_encoder("ffmpeg -loglevel error -y -i - -c:v libx264 -pix_fmt yuv420p " + path,
+                                                     StreamSink::Format::Y4M, job.fps);
+                if (!stream->ok()) return nullptr;
+                target = std::move(stream);
+                break;
+            }
+            case JobSpec::Sink::Y4m: {
+                auto stream = StreamSink::to_file(path, StreamSink::Format::Y4M, job.fps);
+                if (!stream->ok()) return nullptr;
+                target = std::move(stream);
+                break;
+            }
+            case JobSpec::Sink::Ppm: {
+                std::error_code ec;
+                std::filesystem::create_directories(path, ec);
+                if (ec) { std::cerr << "Error creating " << path << ": " << ec.message() << std::endl; return nullptr; }
+                target = std::make_unique<PpmFileSink>(path);
+                break;
+            }
+            default:
+                target = std::make_unique<DeltaFileSink>(path, job.fps);
+                break;
+        }
+        return std::make_unique<AsyncSink>(std::move(target), spec.frame_queue);
+    }
+
+    template <std::floating_point T>
+    void sample_curve(const JobSpec& job, Zeta::Parallel::WorkStealingPool* pool, SampledJob& out) {
+        const bool hardy = job.kind == JobSpec::Kind::Hardy;
+
+        // Half a pixel of the drawn curve unless given
+        Zeta::Hardy::AdaptiveOptions options;
+        options.method = job.method;
+        options.options.threads = 1;
+        options.options.pool = pool;
+        options.curve = hardy ? Zeta::Hardy::AdaptiveOptions::Curve::Hardy : Zeta::Hardy::AdaptiveOptions::Curve::Zeta;
+        options.tolerance = (job.tolerance > 0.0) ? job.tolerance
+                          : hardy ? HARDY_RANGE / (2.0 * job.height) : ZETA_RANGE / (2.0 * job.width);
+
+        const Zeta::Hardy::Samples<T> samples = Zeta::Hardy::sampleAdaptive<T>(static_cast<T>(job.t0), static_cast<T>(job.t1), options);
+        out.t.assign(samples.t.begin(), samples.t.end());
+        out.z.assign(samples.z.begin(), samples.z.end());
+        out.theta.assign(samples.theta.begin(), samples.theta.end());
+    }
+
+    template <std::floating_point T>
+    void sample_plane(const JobSpec& job, Zeta::Parallel::WorkStealingPool* pool, SampledJob& out) {
+        const Zeta::Plane::Region<T> region{ static_cast<T>(job.sigma0), static_cast<T>(job.sigma1),
+                                             static_cast<T>(job.t0), static_cast<T>(job.t1) };
+        Zeta::Options options;
+        options.threads = 1;
+        options.pool = pool;
+        options.em_tolerance = (job.tolerance > 0.0) ? job.tolerance : 1e-10;
+
+        const std::vector<std::complex<T>> values = Zeta::Plane::evaluate<T>(region, job.width, job.height, options);
+        out.plane.resize(values.size());
+        std::ranges::transform(values, out.plane.begin(), [](std::complex<T> w) {
+            return std::complex<double>(static_cast<double>(w.real()), static_cast<double>(w.imag()));
+        });
+    }
+
+    // Stage 1: Z(t) samples or the zeta grid, in the job's precision, on `pool` (sequentially without one)
+    template <std::floating_point T>
+    void sample(const JobSpec& job, Zeta::Parallel::WorkStealingPool* pool, SampledJob& out) {
+        if (job.kind == JobSpec::Kind::Plane) sample_plane<T>(job, pool, out);
+        else sample_curve<T>(job, pool, out);
+    }
+
+    // Stages 2 and 3: draws the frames into the job's sink, whose writer thread encodes them
+    bool render(const BatchSpec& spec, const SampledJob& sampled) {
+        const JobSpec& job = *sampled.job;
+        const std::string path = output_path(spec, job);
+
+        if (job.kind == JobSpec::Kind::Plane) {
+            std::vector<Color> colors(sampled.plane.size());
+            std::ranges::transform(sampled.plane, colors.begin(), &PlotCanvas::domain_color);
+            // One thread: the rasterizer is this job's share of the budget
+            PlotCanvas canvas(job.width, job.height);
+            return canvas.draw_image(colors, job.width, job.height, 1).save(path);
+        }
+
+        std::unique_ptr<FrameSink> sink = make_sink(spec, job);
+        if (!sink) return false;
+
+        const int frames = (job.frames > 0) ? job.frames : static_cast<int>(sampled.t.size()) - 1;
+        PlotCanvas canvas(job.width, job.height);
+        canvas.set_progress(false).fill_background(BLACK);
+        if (job.kind == JobSpec::Kind::Hardy) {
+            canvas.draw_baseline(job.height / 2, GRAY).animate_function(*sink, std::span<const double>(sampled.t),
+                                                                        std::span<const double>(sampled.z), frames, BLUE, GOLD);
+        } else {
+            canvas.animate_complex_zeta(*sink, std::span<const double>(sampled.t), std::span<const double>(sampled.z),
+                                        std::span<const double>(sampled.theta), frames, BLUE, GOLD);
+        }
+        sink->finish();
+        return true;
+    }
+
+}
+
+BatchSpec default_batch() {
+    BatchSpec spec;
+
+    JobSpec hardy;
+    hardy.kind = JobSpec::Kind::Hardy;
+    hardy.t0 = 10000.0;
+    hardy.t1 = 10100.0;
+    hardy.frames = 6000;
+    hardy.width = 600;
+    hardy.height = 300;
+
+    JobSpec hardy_em = hardy;
+    hardy_em.name = "hardyEM";
+    hardy_em.method = Zeta::Method::EulerMaclaurin;
+
+    JobSpec hardy_rs = hardy;
+    hardy_rs.name = "hardyRS";
+    hardy_rs.method = Zeta::Method::RiemannSiegel;
+
+    JobSpec zeta = hardy;
+    zeta.name = "zeta";
+    zeta.kind = JobSpec::Kind::Zeta;
+    zeta.method = Zeta::Method::EulerMaclaurin;
+    zeta.height = 600;
+
+    // Domain coloring of zeta over the critical strip and its neighbourhood
+    JobSpec plane;
+    plane.name = "zeta_plane";
+    plane.kind = JobSpec::Kind::Plane;
+    plane.sigma0 = -1.0;
+    plane.sigma1 = 2.0;
+    plane.t0 = 0.0;
+    plane.t1 = 40.0;
+    plane.width = 600;
+    plane.height = 600;
+
+    // Longest first, so the short jobs fill in around it
+    spec.jobs = { zeta, hardy_em, hardy_rs, plane };
+    return spec;
+}
+
+bool parse_batch(std::istream& in, BatchSpec& spec, std::string& error) {
+    std::string line;
+    int number = 0;
+    JobSpec* job = nullptr;
+
+    while (std::getline(in, line)) {
+        ++number;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']' || line.size() < 3) { error = "line " + std::to_string(number) + ": bad section"; return false; }
+            spec.jobs.push_back(JobSpec{});
+            job = &spec.jobs.back();
+            job->name = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        const auto equals = line.find('=');
+        if (equals == std::string::npos) { error = "line " + std::to_string(number) + ": expected key = value"; return false; }
+        const std::string key = trim(line.substr(0, equals));
+        const std::string value = trim(line.substr(equals + 1));
+
+        bool ok = false;
+        try {
+            ok = job ? set_job_key(*job, key, value) : set_batch_key(spec, key, value);
+        } catch (const std::exception&) {
+            ok = false;
+        }
+        if (!ok) { error = "line " + std::to_string(number) + ": bad " + (job ? "job" : "batch") + " setting '" + key + "'"; return false; }
+    }
+
+    for (const JobSpec& j : spec.jobs) {
+        const bool plane = j.kind == JobSpec::Kind::Plane;
+        const bool valid = !j.name.empty() && j.width > 0 && j.height > 0 && j.t1 > j.t0 && j.fps > 0
+                        && (plane ? j.sigma1 > j.sigma0 : j.sink != JobSpec::Sink::Image);
+        if (!valid) {
+            error = "job '" + j.name + "': needs a name, t1 > t0, positive sizes, and sigma1 > sigma0 for planes"
+                    " (the image sink is for planes only)";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool run_batch(const BatchSpec& spec) {
+    std::error_code ec;
+    std::filesystem::create_directories(spec.output, ec);
+    if (ec) { std::cerr << "Error creating " << spec.output << ": " << ec.message() << std::endl; return false; }
+
+    const int jobs = static_cast<int>(spec.jobs.size());
+    if (jobs == 0) return true;
+
+    const int budget = Zeta::Parallel::resolveThreads(spec.threads);
+    const int samplers = std::clamp(budget / 2, 1, jobs);
+    const int rasterizers = std::clamp(budget - samplers, 1, jobs);
+    const int evaluation_threads = std::max(1, budget / samplers);
+
+    std::cout << "Running " << jobs << " jobs: " << samplers << " samplers (" << evaluation_threads
+              << " threads each), " << rasterizers << " rasterizers" << std::endl;
+
+    BoundedQueue<std::unique_ptr<SampledJob>> queue(spec.queue);
+    std::atomic<int> next{0};
+    std::atomic<int> samplers_left{samplers};
+    std::atomic<bool> ok{true};
+    std::mutex report_mutex;
+    const auto start = std::chrono::steady_clock::now();
+
+    auto elapsed = [start] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Each sampler evaluates on a pool of its own: a pool runs one parallelFor at a time, so samplers
+    // sharing one would take turns instead of overlapping
+    auto sampler = [&] {
+        const auto pool = (evaluation_threads > 1) ? std::make_unique<Zeta::Parallel::WorkStealingPool>(evaluation_threads) : nullptr;
+        for (int i = next++; i < jobs; i = next++) {
+            const JobSpec& job = spec.jobs[i];
+            auto sampled = std::make_unique<SampledJob>();
+            sampled->job = &job;
+            const double begin = elapsed();
+            if (job.precision == "float") sample<float>(job, pool.get(), *sampled);
+            else if (job.precision == "long") sample<long double>(job, pool.get(), *sampled);
+            else sample<double>(job, pool.get(), *sampled);
+            sampled->seconds = elapsed() - begin;
+            queue.push(std::move(sampled));
+        }
+        if (--samplers_left == 0) queue.close();
+    };
+
+    auto rasterizer = [&] {
+        while (std::optional<std::unique_ptr<SampledJob>> item = queue.pop()) {
+            const SampledJob& sampled = **item;
+            const double begin = elapsed();
+            const bool written = render(spec, sampled);
+            if (!written) ok = false;
+
+            std::lock_guard lock(report_mutex);
+            std::cout << sampled.job->name << ": " << (written ? output_path(spec, *sampled.job) : "failed")
+                      << " (sampled " << sampled.t.size() + sampled.plane.size() << " points in " << sampled.seconds
+                      << " s, drawn and written in " << elapsed() - begin << " s)" << std::endl;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < samplers; ++i) threads.emplace_back(sampler);
+    for (int i = 0; i < rasterizers; ++i) threads.emplace_back(rasterizer);
+    for (std::thread& thread : threads) thread.join();
+
+    std::cout << "All jobs finished in " << elapsed() << " s" << std::endl;
+
+    bool delta_outputs = false;
+    for (const JobSpec& job : spec.jobs) {
+        if (resolve_sink(job) != JobSpec::Sink::Delta) continue;
+        if (!delta_outputs) std::cout << "To create the videos, run:" << std::endl;
+        delta_outputs = true;
+        const std::string base = spec.output + "/" + job.name;
+        std::cout << "output/delta_expand " << base << ".pdl - | ffmpeg -i - -c:v libx264 -pix_fmt yuv420p "
+                  << base << ".mp4" << std::endl;
+    }
+    return ok;
+}
@@ -0,0 +1,85 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include <istream>
+#include "HardyZ.h"
+
+// One animation or image of a batch.
+struct JobSpec {
+    enum class Kind {
+        Hardy, // Z(t) over [t0, t1], animated left to right
+        Zeta,  // zeta(1/2 + it) over [t0, t1] in the complex plane, animated
+        Plane  // still image: domain coloring of zeta over [sigma0, sigma1] x [t0, t1]
+    };
+
+    enum class Sink {
+        Auto,   // Ffmpeg when ffmpeg is on the PATH, Delta otherwise
+        Ffmpeg, // <output>/<name>.mp4 through an ffmpeg pipe
+        Delta,  // <output>/<name>.pdl (expand with delta_expand)
+        Y4m,    // <output>/<name>.y4m
+        Ppm,    // <output>/<name>/frame_%04d.ppm
+        Image   // <output>/<name>.ppm, the only sink of Kind::Plane
+    };
+
+    std::string name;
+    Kind kind = Kind::Hardy;
+    Zeta::Method method = Zeta::Method::RiemannSiegelRemainder;
+    std::string precision = "double"; // float | double | long: the type Z(t) is sampled in
+    double t0 = 0.0;
+    double t1 = 0.0;
+    double sigma0 = -1.0;
+    double sigma1 = 2.0;
+    int frames = 0;       // 0: one frame per sample
+    int width = 600;
+    int height = 300;
+    double tolerance = 0.0; // sampling tolerance in plot units (0: half a pixel); zeta accuracy for Kind::Plane
+                            // (absolute, relative to |chi(s)| left of the critical line)
+    Sink sink = Sink::Auto;
+    int fps = 300;
+};
+
+// A set of jobs sharing an output directory and a thread budget.
+struct BatchSpec {
+    std::string output = "output";
+    int threads = 0;     // whole budget, <= 0: all hardware threads
+    int queue = 2;       // sampled jobs waiting for a rasterizer
+    int frame_queue = 8; // frames waiting for each sink's writer (AsyncSink depth)
+    std::vector<JobSpec> jobs;
+};
+
+// The demo: Z(t) by Euler-Maclaurin and Riemann-Siegel and zeta(1/2 + it) on [10000, 10100] in 6000
+// frames each, and the domain coloring of the critical strip for 0 <= t <= 40.
+BatchSpec default_batch();
+
+// Reads a job file into `spec`, keeping its defaults for keys that are not given:
+//
+//   # comment
+//   output = output            global keys before the first section: output, threads, queue, frame_queue
+//   threads = 0
+//   [hardyEM]                  one section per job, named after its output
+//   kind = hardy               hardy | zeta | plane
+//   method = em                em | rs | rsr | os
+//   precision = double         float | double | long
+//   t0 = 10000
+//   t1 = 10100
+//   frames = 6000
+//   width = 600
+//   height = 300
+//   sink = auto                auto | ffmpeg | delta | y4m | ppm | image
+//   fps = 300
+//
+// plus sigma0, sigma1 and tolerance. Returns false with a message naming the line on errors.
+bool parse_batch(std::istream& in, BatchSpec& spec, std::string& error);
+
+// Runs the jobs as a pipeline: sampler threads evaluate Z(t) (or the zeta grid) job by job and hand
+// the samples through a bounded queue to rasterizer threads, which draw the frames into one AsyncSink
+// per job, whose writer thread encodes them. Jobs overlap, so one job's sampling runs while another's
+// frames are drawn and a third's are written. Half the thread budget samples and half rasterizes
+// (at least one thread each, at most one per job); each sampler evaluates on a pool of its own with
+// budget / samplers threads, as rasterizers mostly wait on their writers. Returns false if an output
+// could not be opened.
+bool run_batch(const BatchSpec& spec);
+
+#endif
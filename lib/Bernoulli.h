@@ -1,22 +1,28 @@
 #pragma once
 
-#include <vector>
+#include <array>
 #include <concepts>
 
 namespace Zeta {
 
+    /**
+     * @brief Number of tabulated Bernoulli numbers (indices 0 .. limit-1).
+     */
+    inline constexpr int BERNOULLI_TABLE_SIZE = 512;
+
     /**
      * @brief Retrieves the n-th Bernoulli number B_n.
-     * Uses a local static cache to store previously computed values (Memoization).
-     * Formula:
-     * $$ B_m = \frac{-1}{m+1} \sum_{k=0}^{m-1} \binom{m+1}{k} B_k $$
+     * The numbers are tabulated at compile time (detail::BERNOULLI_TABLE), so calls with a constant
+     * index fold to a constant and the rest are one load.
      * @tparam T Floating point type (float, double, long double).
      * @param n The index (must be >= 0).
-     * @return The Bernoulli number.
+     * @return The Bernoulli number (NaN outside [0, BERNOULLI_TABLE_SIZE)).
+     * @note $ |B_{2k}| $ grows like $ 2 (2k)! / (2\pi)^{2k} $, so the even numbers overflow to $ \pm\infty $
+     * from $ n = 66 $ in float and $ n = 260 $ in double; long double holds the whole table.
      */
     template <std::floating_point T>
     [[nodiscard]]
-    T bernoulli(int n);
+    constexpr T bernoulli(int n);
 
 } 
 
@@ -1,64 +1,56 @@
-#include <vector>
 #include <cmath>
-#include <numeric>    
-#include <ranges>    
-#include <algorithm> 
+#include <array>
+#include <limits>
 
 namespace Zeta {
 
-    /**
-     * @brief Computes the Binomial Coefficient $\binom{n}{k}$ (n choose k).
-     * **Definition:**
-     * $$ \binom{n}{k} = \frac{n!}{k!(n-k)!} $$
-     * **Implementation:**
-     * Uses the multiplicative formula to avoid calculating large factorials directly:
-     * $$ \binom{n}{k} = \prod_{i=1}^k \frac{n - i + 1}{i} $$
-     * @note Marked `constexpr`. If $n$ and $k$ are compile-time constants, 
-     * this value is computed by the compiler (Zero Runtime Cost).
-     * @param n Total number of items.
-     * @param k Number of items to choose.
-     * @return The binomial coefficient as a double.
-     */
-    constexpr double nCr_impl(int n, int k) {
-        if (k < 0 || k > n) return 0.0;
-        if (k == 0 || k == n) return 1.0;
+    namespace detail {
+
+        /**
+         * @brief Builds $ B_0, \dots, B_{limit-1} $ in long double.
+         * **Construction:**
+         * The recurrence $ B_m = \frac{-1}{m+1} \sum_{k=0}^{m-1} \binom{m+1}{k} B_k $ cancels alternating terms
+         * and loses all digits by $ m \approx 100 $. The tangent numbers $ T_k $ instead follow from sums of
+         * positive terms (Brent & Harvey, *Fast computation of Bernoulli, Tangent and Secant numbers*), so
+         * $$ B_{2k} = (-1)^{k-1} \frac{2k \, T_k}{4^k (4^k - 1)} $$
+         * keeps full precision; $ B_1 = -\frac{1}{2} $ and the odd ones above vanish.
+         */
+        consteval std::array<long double, BERNOULLI_TABLE_SIZE> buildBernoulliTable() {
+            using LD = long double;
+            constexpr int K = (BERNOULLI_TABLE_SIZE - 1) / 2;
+
+            std::array<LD, K + 1> tangent{};
+            tangent[1] = LD{1};
+            for (int k = 2; k <= K; ++k) tangent[k] = static_cast<LD>(k - 1) * tangent[k - 1];
+            for (int k = 2; k <= K; ++k) {
+                for (int j = k; j <= K; ++j) {
+                    tangent[j] = static_cast<LD>(j - k) * tangent[j - 1] + static_cast<LD>(j - k + 2) * tangent[j];
+                }
+            }
 
-        if (k > n / 2) k = n - k;
+            std::array<LD, BERNOULLI_TABLE_SIZE> table{};
+            table[0] = LD{1};
+            table[1] = LD{-0.5};
+            LD four_k = LD{1};
+            for (int k = 1; k <= K; ++k) {
+                four_k *= LD{4};
+                const LD sign = (k % 2 == 1) ? LD{1} : LD{-1};
+                table[2 * k] = sign * static_cast<LD>(2 * k) * tangent[k] / (four_k * (four_k - LD{1}));
+            }
+            return table;
+        }
 
-        auto range = std::views::iota(1, k + 1);
+        /**
+         * @brief $ B_0, \dots, B_{limit-1} $, evaluated by the compiler.
+         */
+        inline constexpr std::array<long double, BERNOULLI_TABLE_SIZE> BERNOULLI_TABLE = buildBernoulliTable();
 
-        return std::ranges::fold_left(
-            range, 
-            1.0, 
-            [n](double acc, int i) {
-                return acc * (n - i + 1) / i;
-            }
-        );
     }
 
     template <std::floating_point T>
-    T bernoulli(int n) {
-        static std::vector<T> cache = { T{1.0} }; // B_0 = 1
-
-        if (n < static_cast<int>(cache.size())) return cache[n];
-
-        for (int m = cache.size(); m <= n; ++m) {
-            auto k_range = std::views::iota(0, m);
-
-            T sum = std::ranges::fold_left(
-                k_range,
-                T{0},
-                [m](T acc, int k) {
-                    T combinations = static_cast<T>(nCr_impl(m + 1, k));
-                    return acc + (combinations * cache[k]);
-                }
-            );
-
-            T b_m = (T{-1} / static_cast<T>(m + 1)) * sum; // B_m = -1/(m+1) * sum
-            cache.push_back(b_m);
-        }
-
-        return cache[n];
+    constexpr T bernoulli(int n) {
+        if (n < 0 || n >= BERNOULLI_TABLE_SIZE) return std::numeric_limits<T>::quiet_NaN();
+        return static_cast<T>(detail::BERNOULLI_TABLE[n]);
     }
 
-} 
\ No newline at end of file
+} 
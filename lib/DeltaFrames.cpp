@@ -0,0 +1,227 @@
+#include "DeltaFrames.h"
+#include "Profile.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+    void put_u32(unsigned char* p, std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+
+    void put_u64(unsigned char* p, std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+
+    std::uint32_t get_u32(const unsigned char* p) {
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    std::uint64_t get_u64(const unsigned char* p) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+}
+
+// =====================================================================
+// DeltaFileSink
+// =====================================================================
+
+DeltaFileSink::DeltaFileSink(const std::string& path, int fps, int keyframe_interval)
+    : out(std::fopen(path.c_str(), "wb")), fps(std::max(fps, 1)), keyframe_interval(std::max(keyframe_interval, 0)) {
+    if (!out) std::cerr << "Error opening " << path << std::endl;
+}
+
+DeltaFileSink::~DeltaFileSink() {
+    finish();
+}
+
+void DeltaFileSink::write_header() {
+    unsigned char header[DeltaFormat::HEADER_SIZE] = {};
+    std::memcpy(header, DeltaFormat::MAGIC, 4);
+    put_u32(header + 4, DeltaFormat::VERSION);
+    put_u32(header + 8, static_cast<std::uint32_t>(width));
+    put_u32(header + 12, static_cast<std::uint32_t>(height));
+    put_u32(header + 16, static_cast<std::uint32_t>(fps));
+    put_u32(header + 20, static_cast<std::uint32_t>(index.size()));
+    put_u64(header + 24, offset);
+    std::fwrite(header, 1, sizeof(header), out);
+}
+
+void DeltaFileSink::write_frame(const unsigned char* rgb, int width, int height, int index) {
+    write_delta(rgb, width, height, index, DirtyRect{ 0, 0, width, height });
+}
+
+void DeltaFileSink::write_delta(const unsigned char* rgb, int width, int height, int frame_index, const DirtyRect& dirty) {
+    if (!out) return;
+    (void)frame_index;
+
+    if (index.empty()) {
+        this->width = width;
+        this->height = height;
+        write_header(); // placeholder; finish() rewrites it with the frame count
+        offset = DeltaFormat::HEADER_SIZE;
+    }
+
+    // Clip to the canvas, and widen to a keyframe on the first frame and every keyframe_interval
+    DirtyRect rect{ std::max(dirty.x0, 0), std::max(dirty.y0, 0),
+                    std::min(dirty.x1, width), std::min(dirty.y1, height) };
+    const int count = static_cast<int>(index.size());
+    if (count == 0 || (keyframe_interval > 0 && count % keyframe_interval == 0)) {
+        rect = { 0, 0, width, height };
+    }
+    if (rect.empty()) rect = {};
+
+    index.push_back(offset);
+
+    const int w = rect.x1 - rect.x0;
+    const int h = rect.y1 - rect.y0;
+    unsigned char record[DeltaFormat::RECORD_HEADER_SIZE];
+    put_u32(record, static_cast<std::uint32_t>(rect.x0));
+    put_u32(record + 4, static_cast<std::uint32_t>(rect.y0));
+    put_u32(record + 8, static_cast<std::uint32_t>(w));
+    put_u32(record + 12, static_cast<std::uint32_t>(h));
+    std::fwrite(record, 1, sizeof(record), out);
+
+    for (int y = rect.y0; y < rect.y1; ++y) {
+        const unsigned char* row = rgb + (static_cast<std::size_t>(y) * width + rect.x0) * 3;
+        std::fwrite(row, 1, static_cast<std::size_t>(w) * 3, out);
+    }
+    offset += DeltaFormat::RECORD_HEADER_SIZE + static_cast<std::uint64_t>(w) * h * 3;
+    ZETA_COUNT(BytesWritten, DeltaFormat::RECORD_HEADER_SIZE + static_cast<std::uint64_t>(w) * h * 3);
+}
+
+void DeltaFileSink::finish() {
+    if (!out) return;
+
+    if (!index.empty()) {
+        std::vector<unsigned char> table(index.size() * 8);
+        for (std::size_t i = 0; i < index.size(); ++i) put_u64(table.data() + 8 * i, index[i]);
+        std::fwrite(table.data(), 1, table.size(), out);
+
+        std::fseek(out, 0, SEEK_SET);
+        write_header(); // offset now points at the index
+        offset += table.size();
+    }
+
+    std::fclose(out);
+    out = nullptr;
+}
+
+// =====================================================================
+// DeltaReader
+// =====================================================================
+
+DeltaReader::DeltaReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { std::cerr << "Error opening " << path << std::endl; return; }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < DeltaFormat::HEADER_SIZE) {
+        std::cerr << "Not a delta frame file: " << path << std::endl;
+        ::close(fd);
+        return;
+    }
+
+    void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) { std::cerr << "Error mapping " << path << std::endl; return; }
+
+    data = static_cast<const unsigned char*>(map);
+    size = static_cast<std::size_t>(st.st_size);
+
+    const std::uint32_t count = get_u32(data + 20);
+    const std::uint64_t index_offset = get_u64(data + 24);
+    // An unfinished file still has the placeholder header (count 0, index_offset 0); finish()
+    // always places the index after the header and the frames
+    if (std::memcmp(data, DeltaFormat::MAGIC, 4) != 0 || get_u32(data + 4) != DeltaFormat::VERSION
+        || index_offset < DeltaFormat::HEADER_SIZE
+        || index_offset + static_cast<std::uint64_t>(count) * 8 > size) {
+        std::cerr << "Not a delta frame file (or not finished): " << path << std::endl;
+        ::munmap(const_cast<unsigned char*>(data), size);
+        data = nullptr;
+        return;
+    }
+
+    w = static_cast<int>(get_u32(data + 8));
+    h = static_cast<int>(get_u32(data + 12));
+    rate = static_cast<int>(get_u32(data + 16));
+    offsets.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        offsets[i] = get_u64(data + index_offset + 8 * i);
+        if (offsets[i] + DeltaFormat::RECORD_HEADER_SIZE > index_offset) {
+            std::cerr << "Corrupt frame index in " << path << std::endl;
+            offsets.clear();
+            break;
+        }
+    }
+}
+
+DeltaReader::~DeltaReader() {
+    if (data) ::munmap(const_cast<unsigned char*>(data), size);
+}
+
+bool DeltaReader::is_keyframe(int i) const {
+    const unsigned char* record = data + offsets[i];
+    return get_u32(record) == 0 && get_u32(record + 4) == 0
+        && static_cast<int>(get_u32(record + 8)) == w && static_cast<int>(get_u32(record + 12)) == h;
+}
+
+bool DeltaReader::apply(int i) {
+    const unsigned char* record = data + offsets[i];
+    const std::uint32_t x0 = get_u32(record);
+    const std::uint32_t y0 = get_u32(record + 4);
+    const std::uint32_t rw = get_u32(record + 8);
+    const std::uint32_t rh = get_u32(record + 12);
+
+    if (static_cast<std::uint64_t>(x0) + rw > static_cast<std::uint64_t>(w)
+        || static_cast<std::uint64_t>(y0) + rh > static_cast<std::uint64_t>(h)
+        || offsets[i] + DeltaFormat::RECORD_HEADER_SIZE + static_cast<std::uint64_t>(rw) * rh * 3 > size) {
+        return false;
+    }
+
+    const unsigned char* patch = record + DeltaFormat::RECORD_HEADER_SIZE;
+    for (std::uint32_t y = 0; y < rh; ++y) {
+        std::memcpy(canvas.data() + ((static_cast<std::size_t>(y0 + y) * w) + x0) * 3,
+                    patch + static_cast<std::size_t>(y) * rw * 3,
+                    static_cast<std::size_t>(rw) * 3);
+    }
+    return true;
+}
+
+const unsigned char* DeltaReader::frame(int i) {
+    if (!data || i < 0 || i >= frames()) return nullptr;
+
+    canvas.resize(static_cast<std::size_t>(w) * h * 3);
+
+    int from = i;
+    if (last_decoded >= 0 && last_decoded < i) {
+        from = last_decoded + 1;
+    } else {
+        while (from > 0 && !is_keyframe(from)) --from;
+    }
+
+    for (int k = from; k <= i; ++k) {
+        if (!apply(k)) { last_decoded = -1; return nullptr; }
+    }
+    last_decoded = i;
+    return canvas.data();
+}
+
+void DeltaReader::expand(FrameSink& sink) {
+    for (int i = 0; i < frames(); ++i) {
+        const unsigned char* rgb = frame(i);
+        if (!rgb) { std::cerr << "Corrupt frame " << i << std::endl; break; }
+        sink.write_frame(rgb, w, h, i);
+    }
+    sink.finish();
+}
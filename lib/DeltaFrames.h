@@ -0,0 +1,87 @@
+#ifndef DELTA_FRAMES_H
+#define DELTA_FRAMES_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include "FrameSink.h"
+
+// Delta frame file (.pdl): one keyframe followed by dirty-rectangle patches.
+//
+//   header   "PDLT" | u32 version | u32 width | u32 height | u32 fps | u32 frames | u64 index_offset
+//   record   u32 x | u32 y | u32 w | u32 h | w * h * 3 bytes of RGB rows   (one per frame)
+//   index    u64 offset of every record, at index_offset
+//
+// Integers are little-endian. A record covering the whole canvas is a keyframe; an empty one
+// (w = h = 0) repeats the previous frame. `frames` and `index_offset` are filled in by finish().
+namespace DeltaFormat {
+    inline constexpr char MAGIC[4] = { 'P', 'D', 'L', 'T' };
+    inline constexpr std::uint32_t VERSION = 1;
+    inline constexpr std::size_t HEADER_SIZE = 32;
+    inline constexpr std::size_t RECORD_HEADER_SIZE = 16;
+}
+
+// Writes a delta frame file. Only the dirty box of each frame is stored; a full frame is
+// forced every `keyframe_interval` frames (0: only the first) so readers can seek.
+class DeltaFileSink : public FrameSink {
+public:
+    DeltaFileSink(const std::string& path, int fps, int keyframe_interval = 0);
+    ~DeltaFileSink() override;
+
+    void write_frame(const unsigned char* rgb, int width, int height, int index) override;
+    void write_delta(const unsigned char* rgb, int width, int height, int index, const DirtyRect& dirty) override;
+    void finish() override;
+
+    std::uint64_t bytes_written() const { return offset; }
+
+private:
+    void write_header();
+
+    std::FILE* out;
+    int fps;
+    int keyframe_interval;
+    int width = 0;
+    int height = 0;
+    std::uint64_t offset = 0;
+    std::vector<std::uint64_t> index;
+};
+
+// Memory-maps a delta frame file and replays it into an RGB canvas.
+class DeltaReader {
+public:
+    explicit DeltaReader(const std::string& path);
+    ~DeltaReader();
+
+    DeltaReader(const DeltaReader&) = delete;
+    DeltaReader& operator=(const DeltaReader&) = delete;
+
+    bool ok() const { return data != nullptr; }
+    int width() const { return w; }
+    int height() const { return h; }
+    int fps() const { return rate; }
+    int frames() const { return static_cast<int>(offsets.size()); }
+
+    // Decodes frame `i` and returns its width * height * 3 RGB bytes (valid until the next call),
+    // or nullptr if the file is corrupt. Stepping forward applies one patch per frame;
+    // seeking backwards replays from the closest keyframe at or before `i`.
+    const unsigned char* frame(int i);
+
+    // Replays every frame into `sink`, e.g. a PpmFileSink or a Y4M StreamSink.
+    void expand(FrameSink& sink);
+
+private:
+    bool apply(int i);
+    bool is_keyframe(int i) const;
+
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    int w = 0;
+    int h = 0;
+    int rate = 0;
+    std::vector<std::uint64_t> offsets;
+    std::vector<unsigned char> canvas;
+    int last_decoded = -1;
+};
+
+#endif
@@ -0,0 +1,336 @@
+#include "Dirichlet.h"
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <immintrin.h>
+
+namespace Zeta {
+
+    namespace {
+
+        // pi/2 = PIO2_1 + PIO2_2 + PIO2_3 (each the double nearest to the remaining tail)
+        constexpr double PIO2_1 = 1.5707963267948966192e+00;
+        constexpr double PIO2_2 = 6.1232339957367660360e-17;
+        constexpr double PIO2_3 = -1.4973849048591698329e-33;
+        constexpr double TWO_OVER_PI = 6.3661977236758134308e-01;
+        constexpr double INV_TWO_PI = 1.5915494309189534561e-01;
+
+        // Adding 1.5 * 2^52 to an integral double leaves the integer in the low mantissa bits
+        constexpr double ROUND_MAGIC = 6755399441055744.0;
+
+        // Taylor coefficients on [-pi/4, pi/4]; truncation error < 1e-17
+        constexpr double S3  = -1.0 / 6.0;
+        constexpr double S5  =  1.0 / 120.0;
+        constexpr double S7  = -1.0 / 5040.0;
+        constexpr double S9  =  1.0 / 362880.0;
+        constexpr double S11 = -1.0 / 39916800.0;
+        constexpr double S13 =  1.0 / 6227020800.0;
+        constexpr double S15 = -1.0 / 1307674368000.0;
+        constexpr double S17 =  1.0 / 355687428096000.0;
+
+        constexpr double C2  = -1.0 / 2.0;
+        constexpr double C4  =  1.0 / 24.0;
+        constexpr double C6  = -1.0 / 720.0;
+        constexpr double C8  =  1.0 / 40320.0;
+        constexpr double C10 = -1.0 / 3628800.0;
+        constexpr double C12 =  1.0 / 479001600.0;
+        constexpr double C14 = -1.0 / 87178291200.0;
+        constexpr double C16 =  1.0 / 20922789888000.0;
+
+        double cosSumScalar(const double* log_n, const double* inv_sqrt_n, int N, double theta, double t) noexcept {
+            double sum = 0.0;
+            for (int i = 0; i < N; ++i) {
+                sum += inv_sqrt_n[i] * std::cos(theta - t * log_n[i]);
+            }
+            return sum;
+        }
+
+        // theta - t (l + l_lo) with theta already reduced modulo 2 pi. The product t l is split exactly
+        // by FMA and reduced against the two-part 2 pi; x - k 2pi_hi is exact up to its final rounding.
+        inline double precisePhase(double log_n, double log_n_lo, double theta, double t) noexcept {
+            const double p = t * log_n;
+            const double p_lo = std::fma(t, log_n_lo, std::fma(t, log_n, -p));
+            const double k = std::nearbyint(p * INV_TWO_PI);
+            return theta - (std::fma(-k, DD::TWO_PI.hi, p) + std::fma(-k, DD::TWO_PI.lo, p_lo));
+        }
+
+        double cosSumPreciseScalar(const double* log_n, const double* log_n_lo, const double* inv_sqrt_n, int N,
+                                   double theta, double t) noexcept {
+            double sum = 0.0;
+            for (int i = 0; i < N; ++i) {
+                sum += inv_sqrt_n[i] * std::cos(precisePhase(log_n[i], log_n_lo[i], theta, t));
+            }
+            return sum;
+        }
+
+        // ---------------------------------------------------------------
+        // AVX2 + FMA: 4 lanes
+        // ---------------------------------------------------------------
+
+        __attribute__((target("avx2,fma")))
+        inline __m256d cos4(__m256d x) noexcept {
+            const __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(TWO_OVER_PI)),
+                                              _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+            __m256d y = _mm256_fnmadd_pd(k, _mm256_set1_pd(PIO2_1), x);
+            y = _mm256_fnmadd_pd(k, _mm256_set1_pd(PIO2_2), y);
+            y = _mm256_fnmadd_pd(k, _mm256_set1_pd(PIO2_3), y);
+
+            const __m256d y2 = _mm256_mul_pd(y, y);
+
+            __m256d s = _mm256_set1_pd(S17);
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S15));
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S13));
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S11));
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S9));
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S7));
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S5));
+            s = _mm256_fmadd_pd(s, y2, _mm256_set1_pd(S3));
+            s = _mm256_fmadd_pd(_mm256_mul_pd(s, y2), y, y);
+
+            __m256d c = _mm256_set1_pd(C16);
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C14));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C12));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C10));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C8));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C6));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C4));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(C2));
+            c = _mm256_fmadd_pd(c, y2, _mm256_set1_pd(1.0));
+
+            // cos(y + j pi/2): j odd selects sin, j in {1, 2} (mod 4) flips the sign
+            const __m256i j = _mm256_castpd_si256(_mm256_add_pd(k, _mm256_set1_pd(ROUND_MAGIC)));
+            const __m256i one = _mm256_set1_epi64x(1);
+            const __m256i odd = _mm256_cmpeq_epi64(_mm256_and_si256(j, one), one);
+            const __m256i flip = _mm256_slli_epi64(
+                _mm256_and_si256(_mm256_add_epi64(j, one), _mm256_set1_epi64x(2)), 62);
+
+            const __m256d r = _mm256_blendv_pd(c, s, _mm256_castsi256_pd(odd));
+            return _mm256_xor_pd(r, _mm256_castsi256_pd(flip));
+        }
+
+        __attribute__((target("avx2,fma")))
+        double cosSumAVX2(const double* log_n, const double* inv_sqrt_n, int N, double theta, double t) noexcept {
+            const __m256d vt = _mm256_set1_pd(t);
+            const __m256d vtheta = _mm256_set1_pd(theta);
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+
+            int i = 0;
+            for (; i + 8 <= N; i += 8) {
+                const __m256d x0 = _mm256_fnmadd_pd(vt, _mm256_loadu_pd(log_n + i), vtheta);
+                const __m256d x1 = _mm256_fnmadd_pd(vt, _mm256_loadu_pd(log_n + i + 4), vtheta);
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(inv_sqrt_n + i), cos4(x0), acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(inv_sqrt_n + i + 4), cos4(x1), acc1);
+            }
+            for (; i + 4 <= N; i += 4) {
+                const __m256d x = _mm256_fnmadd_pd(vt, _mm256_loadu_pd(log_n + i), vtheta);
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(inv_sqrt_n + i), cos4(x), acc0);
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+            double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            return sum + cosSumScalar(log_n + i, inv_sqrt_n + i, N - i, theta, t);
+        }
+
+        __attribute__((target("avx2,fma")))
+        inline __m256d precisePhase4(__m256d l, __m256d l_lo, __m256d theta, __m256d t) noexcept {
+            const __m256d p = _mm256_mul_pd(t, l);
+            const __m256d p_lo = _mm256_fmadd_pd(t, l_lo, _mm256_fmsub_pd(t, l, p));
+            const __m256d k = _mm256_round_pd(_mm256_mul_pd(p, _mm256_set1_pd(INV_TWO_PI)),
+                                              _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            const __m256d r = _mm256_add_pd(_mm256_fnmadd_pd(k, _mm256_set1_pd(DD::TWO_PI.hi), p),
+                                            _mm256_fnmadd_pd(k, _mm256_set1_pd(DD::TWO_PI.lo), p_lo));
+            return _mm256_sub_pd(theta, r);
+        }
+
+        __attribute__((target("avx2,fma")))
+        double cosSumPreciseAVX2(const double* log_n, const double* log_n_lo, const double* inv_sqrt_n, int N,
+                                 double theta, double t) noexcept {
+            const __m256d vt = _mm256_set1_pd(t);
+            const __m256d vtheta = _mm256_set1_pd(theta);
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+
+            int i = 0;
+            for (; i + 8 <= N; i += 8) {
+                const __m256d x0 = precisePhase4(_mm256_loadu_pd(log_n + i), _mm256_loadu_pd(log_n_lo + i), vtheta, vt);
+                const __m256d x1 = precisePhase4(_mm256_loadu_pd(log_n + i + 4), _mm256_loadu_pd(log_n_lo + i + 4), vtheta, vt);
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(inv_sqrt_n + i), cos4(x0), acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(inv_sqrt_n + i + 4), cos4(x1), acc1);
+            }
+            for (; i + 4 <= N; i += 4) {
+                const __m256d x = precisePhase4(_mm256_loadu_pd(log_n + i), _mm256_loadu_pd(log_n_lo + i), vtheta, vt);
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(inv_sqrt_n + i), cos4(x), acc0);
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+            double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            return sum + cosSumPreciseScalar(log_n + i, log_n_lo + i, inv_sqrt_n + i, N - i, theta, t);
+        }
+
+        // ---------------------------------------------------------------
+        // AVX-512F: 8 lanes
+        // ---------------------------------------------------------------
+
+        __attribute__((target("avx512f")))
+        inline __m512d cos8(__m512d x) noexcept {
+            const __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(TWO_OVER_PI)),
+                                                   _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+            __m512d y = _mm512_fnmadd_pd(k, _mm512_set1_pd(PIO2_1), x);
+            y = _mm512_fnmadd_pd(k, _mm512_set1_pd(PIO2_2), y);
+            y = _mm512_fnmadd_pd(k, _mm512_set1_pd(PIO2_3), y);
+
+            const __m512d y2 = _mm512_mul_pd(y, y);
+
+            __m512d s = _mm512_set1_pd(S17);
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S15));
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S13));
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S11));
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S9));
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S7));
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S5));
+            s = _mm512_fmadd_pd(s, y2, _mm512_set1_pd(S3));
+            s = _mm512_fmadd_pd(_mm512_mul_pd(s, y2), y, y);
+
+            __m512d c = _mm512_set1_pd(C16);
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C14));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C12));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C10));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C8));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C6));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C4));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(C2));
+            c = _mm512_fmadd_pd(c, y2, _mm512_set1_pd(1.0));
+
+            const __m512i j = _mm512_castpd_si512(_mm512_add_pd(k, _mm512_set1_pd(ROUND_MAGIC)));
+            const __m512i one = _mm512_set1_epi64(1);
+            const __mmask8 odd = _mm512_test_epi64_mask(j, one);
+            const __m512i flip = _mm512_slli_epi64(
+                _mm512_and_si512(_mm512_add_epi64(j, one), _mm512_set1_epi64(2)), 62);
+
+            const __m512d r = _mm512_mask_blend_pd(odd, c, s);
+            return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(r), flip));
+        }
+
+        __attribute__((target("avx512f")))
+        double cosSumAVX512(const double* log_n, const double* inv_sqrt_n, int N, double theta, double t) noexcept {
+            const __m512d vt = _mm512_set1_pd(t);
+            const __m512d vtheta = _mm512_set1_pd(theta);
+            __m512d acc0 = _mm512_setzero_pd();
+            __m512d acc1 = _mm512_setzero_pd();
+
+            int i = 0;
+            for (; i + 16 <= N; i += 16) {
+                const __m512d x0 = _mm512_fnmadd_pd(vt, _mm512_loadu_pd(log_n + i), vtheta);
+                const __m512d x1 = _mm512_fnmadd_pd(vt, _mm512_loadu_pd(log_n + i + 8), vtheta);
+                acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(inv_sqrt_n + i), cos8(x0), acc0);
+                acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(inv_sqrt_n + i + 8), cos8(x1), acc1);
+            }
+            if (i < N) {
+                // Masked tail: inactive lanes load zero weights
+                const int rest = std::min(N - i, 8);
+                const __mmask8 mask = static_cast<__mmask8>((1u << rest) - 1u);
+                const __m512d x = _mm512_fnmadd_pd(vt, _mm512_maskz_loadu_pd(mask, log_n + i), vtheta);
+                acc0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, inv_sqrt_n + i), cos8(x), acc0);
+                i += rest;
+            }
+            if (i < N) {
+                const __mmask8 mask = static_cast<__mmask8>((1u << (N - i)) - 1u);
+                const __m512d x = _mm512_fnmadd_pd(vt, _mm512_maskz_loadu_pd(mask, log_n + i), vtheta);
+                acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, inv_sqrt_n + i), cos8(x), acc1);
+            }
+
+            return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+        }
+
+        __attribute__((target("avx512f")))
+        inline __m512d precisePhase8(__m512d l, __m512d l_lo, __m512d theta, __m512d t) noexcept {
+            const __m512d p = _mm512_mul_pd(t, l);
+            const __m512d p_lo = _mm512_fmadd_pd(t, l_lo, _mm512_fmsub_pd(t, l, p));
+            const __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(p, _mm512_set1_pd(INV_TWO_PI)),
+                                                   _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            const __m512d r = _mm512_add_pd(_mm512_fnmadd_pd(k, _mm512_set1_pd(DD::TWO_PI.hi), p),
+                                            _mm512_fnmadd_pd(k, _mm512_set1_pd(DD::TWO_PI.lo), p_lo));
+            return _mm512_sub_pd(theta, r);
+        }
+
+        __attribute__((target("avx512f")))
+        double cosSumPreciseAVX512(const double* log_n, const double* log_n_lo, const double* inv_sqrt_n, int N,
+                                   double theta, double t) noexcept {
+            const __m512d vt = _mm512_set1_pd(t);
+            const __m512d vtheta = _mm512_set1_pd(theta);
+            __m512d acc0 = _mm512_setzero_pd();
+            __m512d acc1 = _mm512_setzero_pd();
+
+            int i = 0;
+            for (; i + 16 <= N; i += 16) {
+                const __m512d x0 = precisePhase8(_mm512_loadu_pd(log_n + i), _mm512_loadu_pd(log_n_lo + i), vtheta, vt);
+                const __m512d x1 = precisePhase8(_mm512_loadu_pd(log_n + i + 8), _mm512_loadu_pd(log_n_lo + i + 8), vtheta, vt);
+                acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(inv_sqrt_n + i), cos8(x0), acc0);
+                acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(inv_sqrt_n + i + 8), cos8(x1), acc1);
+            }
+            while (i < N) {
+                // Masked tail: inactive lanes load zero weights
+                const int rest = std::min(N - i, 8);
+                const __mmask8 mask = static_cast<__mmask8>((1u << rest) - 1u);
+                const __m512d x = precisePhase8(_mm512_maskz_loadu_pd(mask, log_n + i),
+                                                _mm512_maskz_loadu_pd(mask, log_n_lo + i), vtheta, vt);
+                acc0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, inv_sqrt_n + i), cos8(x), acc0);
+                i += rest;
+            }
+
+            return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+        }
+
+        using CosSumFn = double (*)(const double*, const double*, int, double, double) noexcept;
+        using CosSumPreciseFn = double (*)(const double*, const double*, const double*, int, double, double) noexcept;
+
+        Kernel detectKernel() noexcept {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return Kernel::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Kernel::AVX2;
+            return Kernel::Scalar;
+        }
+
+        CosSumFn selectCosSum() noexcept {
+            switch (activeKernel()) {
+                case Kernel::AVX512: return cosSumAVX512;
+                case Kernel::AVX2:   return cosSumAVX2;
+                default:             return cosSumScalar;
+            }
+        }
+
+        CosSumPreciseFn selectCosSumPrecise() noexcept {
+            switch (activeKernel()) {
+                case Kernel::AVX512: return cosSumPreciseAVX512;
+                case Kernel::AVX2:   return cosSumPreciseAVX2;
+                default:             return cosSumPreciseScalar;
+            }
+        }
+
+    }
+
+    Kernel activeKernel() noexcept {
+        static const Kernel kernel = detectKernel();
+        return kernel;
+    }
+
+    double cosSum(const double* log_n, const double* inv_sqrt_n, int N, double theta, double t) noexcept {
+        static const CosSumFn fn = selectCosSum();
+        return fn(log_n, inv_sqrt_n, N, theta, t);
+    }
+
+    double cosSumPrecise(const double* log_n, const double* log_n_lo, const double* inv_sqrt_n, int N,
+                         DoubleDouble theta, double t) noexcept {
+        static const CosSumPreciseFn fn = selectCosSumPrecise();
+        // Reduced once here, theta needs no extra precision inside the kernels
+        return fn(log_n, log_n_lo, inv_sqrt_n, N, reduceTwoPi(theta), t);
+    }
+
+}
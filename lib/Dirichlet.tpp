@@ -0,0 +1,77 @@
+#include <cmath>
+#include <ranges>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Zeta {
+
+    template <std::floating_point T>
+    const DirichletTable<T>& dirichletTable(int N) {
+        // Tables are immutable once published; growth publishes a larger copy and keeps
+        // the old generations alive, so references handed out earlier stay valid.
+        static std::atomic<const DirichletTable<T>*> current{nullptr};
+        static std::vector<std::unique_ptr<const DirichletTable<T>>> generations;
+        static std::mutex grow_mutex;
+
+        const DirichletTable<T>* table = current.load(std::memory_order_acquire);
+        if (table && N <= table->size()) return *table;
+
+        std::lock_guard lock(grow_mutex);
+
+        table = current.load(std::memory_order_acquire);
+        const int old_size = table ? table->size() : 0;
+        if (N <= old_size) return *table;
+
+        const int new_size = std::max(N, 2 * old_size);
+        auto grown = std::make_unique<DirichletTable<T>>();
+        grown->log_n.reserve(new_size);
+        grown->log_n_lo.reserve(new_size);
+        grown->inv_sqrt_n.reserve(new_size);
+        if (table) {
+            grown->log_n.assign(table->log_n.begin(), table->log_n.end());
+            grown->log_n_lo.assign(table->log_n_lo.begin(), table->log_n_lo.end());
+            grown->inv_sqrt_n.assign(table->inv_sqrt_n.begin(), table->inv_sqrt_n.end());
+        }
+        grown->log_n.resize(new_size);
+        grown->log_n_lo.resize(new_size);
+        grown->inv_sqrt_n.resize(new_size);
+
+        std::ranges::for_each(
+            std::views::iota(old_size, new_size),
+            [&grown](int i) {
+                T n_val = static_cast<T>(i + 1);
+                grown->log_n[i] = std::log(n_val);
+                grown->log_n_lo[i] = T{0};
+                grown->inv_sqrt_n[i] = T{1} / std::sqrt(n_val);
+            }
+        );
+
+        if constexpr (std::same_as<T, double>) {
+            // ln n in double-double. Zeta::log is costly, so only primes use it;
+            // a composite n = p m adds the (earlier) entries for p and m.
+            std::vector<int> least_factor(new_size + 1, 0);
+            for (int p = 2; p <= new_size; ++p) {
+                if (least_factor[p] != 0) continue;
+                for (int q = p; q <= new_size; q += p) {
+                    if (least_factor[q] == 0) least_factor[q] = p;
+                }
+            }
+
+            auto entry = [&grown](int n) { return DoubleDouble(grown->log_n[n - 1], grown->log_n_lo[n - 1]); };
+            for (int n = std::max(old_size + 1, 2); n <= new_size; ++n) {
+                const int p = least_factor[n];
+                const DoubleDouble log_dd = (p == n) ? Zeta::log(DoubleDouble(static_cast<double>(n)))
+                                                     : entry(p) + entry(n / p);
+                grown->log_n[n - 1] = log_dd.hi;
+                grown->log_n_lo[n - 1] = log_dd.lo;
+            }
+        }
+
+        current.store(grown.get(), std::memory_order_release);
+        generations.push_back(std::move(grown));
+        return *current.load(std::memory_order_relaxed);
+    }
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+namespace Zeta {
+
+    /**
+     * @brief Unevaluated sum $ hi + lo $ of two doubles with $ |lo| \leq \frac{1}{2} \mathrm{ulp}(hi) $.
+     * Carries about 106 significant bits (32 digits) at a few times the cost of double.
+     * Used selectively where double loses digits at large heights: the phases
+     * $ \theta(t) - t \ln n $ and $ -t \ln n $, and $ \theta(t) $ itself. The sums stay in double.
+     * The operators follow the error-free transformations of Dekker and Knuth (as in the QD library).
+     */
+    struct DoubleDouble {
+        double hi = 0.0;
+        double lo = 0.0;
+
+        constexpr DoubleDouble() noexcept = default;
+        constexpr DoubleDouble(double x) noexcept : hi(x), lo(0.0) {}
+        constexpr DoubleDouble(double hi, double lo) noexcept : hi(hi), lo(lo) {}
+
+        [[nodiscard]]
+        explicit constexpr operator double() const noexcept { return hi + lo; }
+    };
+
+    namespace DD {
+
+        /**
+         * @brief $ 2\pi $, $ \pi $ and $ \ln 2 $ to double-double precision.
+         */
+        inline constexpr DoubleDouble TWO_PI { 6.283185307179586232e+00, 2.449293598294706414e-16 };
+        inline constexpr DoubleDouble PI     { 3.141592653589793116e+00, 1.224646799147353207e-16 };
+        inline constexpr DoubleDouble LN2    { 6.931471805599452862e-01, 2.319046813846299558e-17 };
+
+        /**
+         * @brief $ a + b $ exactly, as a rounded sum and its error (Knuth).
+         */
+        [[nodiscard]]
+        constexpr DoubleDouble twoSum(double a, double b) noexcept;
+
+        /**
+         * @brief $ a + b $ exactly, assuming $ |a| \geq |b| $ (Dekker).
+         */
+        [[nodiscard]]
+        constexpr DoubleDouble quickTwoSum(double a, double b) noexcept;
+
+        /**
+         * @brief $ a \cdot b $ exactly, with the error term from one FMA.
+         */
+        [[nodiscard]]
+        DoubleDouble twoProd(double a, double b) noexcept;
+
+    }
+
+    [[nodiscard]] DoubleDouble operator-(DoubleDouble a) noexcept;
+    [[nodiscard]] DoubleDouble operator+(DoubleDouble a, DoubleDouble b) noexcept;
+    [[nodiscard]] DoubleDouble operator-(DoubleDouble a, DoubleDouble b) noexcept;
+    [[nodiscard]] DoubleDouble operator*(DoubleDouble a, double b) noexcept;
+    [[nodiscard]] DoubleDouble operator*(DoubleDouble a, DoubleDouble b) noexcept;
+    [[nodiscard]] DoubleDouble operator/(DoubleDouble a, DoubleDouble b) noexcept;
+
+    /**
+     * @brief $ e^x $ to double-double precision.
+     * Reduces $ x = k \ln 2 + r $, evaluates the Taylor series of $ e^{r/1024} - 1 $ and squares back.
+     */
+    [[nodiscard]]
+    DoubleDouble exp(DoubleDouble x) noexcept;
+
+    /**
+     * @brief $ \ln x $ for $ x > 0 $: one Newton step $ y + x e^{-y} - 1 $ from the double logarithm.
+     */
+    [[nodiscard]]
+    DoubleDouble log(DoubleDouble x) noexcept;
+
+    /**
+     * @brief Reduces $ x $ modulo $ 2\pi $ into $ [-\pi, \pi] $ and rounds to double.
+     * The result is accurate to about 1 ulp of $ \pi $ for $ |x| $ up to $ 2^{50} $.
+     */
+    [[nodiscard]]
+    double reduceTwoPi(DoubleDouble x) noexcept;
+
+}
+
+#include "DoubleDouble.tpp"
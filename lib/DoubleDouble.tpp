@@ -0,0 +1,102 @@
+#include <cmath>
+#include <limits>
+
+namespace Zeta {
+
+    namespace DD {
+
+        constexpr DoubleDouble twoSum(double a, double b) noexcept {
+            const double s = a + b;
+            const double bb = s - a;
+            const double err = (a - (s - bb)) + (b - bb);
+            return { s, err };
+        }
+
+        constexpr DoubleDouble quickTwoSum(double a, double b) noexcept {
+            const double s = a + b;
+            return { s, b - (s - a) };
+        }
+
+        inline DoubleDouble twoProd(double a, double b) noexcept {
+            const double p = a * b;
+            return { p, std::fma(a, b, -p) };
+        }
+
+    }
+
+    inline DoubleDouble operator-(DoubleDouble a) noexcept {
+        return { -a.hi, -a.lo };
+    }
+
+    inline DoubleDouble operator+(DoubleDouble a, DoubleDouble b) noexcept {
+        DoubleDouble s = DD::twoSum(a.hi, b.hi);
+        const DoubleDouble t = DD::twoSum(a.lo, b.lo);
+        s = DD::quickTwoSum(s.hi, s.lo + t.hi);
+        return DD::quickTwoSum(s.hi, s.lo + t.lo);
+    }
+
+    inline DoubleDouble operator-(DoubleDouble a, DoubleDouble b) noexcept {
+        return a + (-b);
+    }
+
+    inline DoubleDouble operator*(DoubleDouble a, double b) noexcept {
+        const DoubleDouble p = DD::twoProd(a.hi, b);
+        return DD::quickTwoSum(p.hi, p.lo + a.lo * b);
+    }
+
+    inline DoubleDouble operator*(DoubleDouble a, DoubleDouble b) noexcept {
+        const DoubleDouble p = DD::twoProd(a.hi, b.hi);
+        return DD::quickTwoSum(p.hi, p.lo + (a.hi * b.lo + a.lo * b.hi));
+    }
+
+    inline DoubleDouble operator/(DoubleDouble a, DoubleDouble b) noexcept {
+        // Long division: two quotient digits, each correcting the remainder of the last
+        const double q1 = a.hi / b.hi;
+        DoubleDouble r = a - b * q1;
+        const double q2 = r.hi / b.hi;
+        r = r - b * q2;
+        const double q3 = r.hi / b.hi;
+        return DD::quickTwoSum(q1, q2) + DoubleDouble(q3);
+    }
+
+    inline DoubleDouble exp(DoubleDouble x) noexcept {
+        constexpr int SQUARINGS = 10;
+        constexpr int TERMS = 10; // |r| < 3.4e-4 after scaling, so r^11/11! < 1e-46
+
+        if (x.hi > 709.0) return { std::numeric_limits<double>::infinity(), 0.0 };
+        if (x.hi < -745.0) return { 0.0, 0.0 };
+
+        const double k = std::nearbyint(x.hi / DD::LN2.hi);
+        DoubleDouble r = x - DD::LN2 * k;
+        r = { std::ldexp(r.hi, -SQUARINGS), std::ldexp(r.lo, -SQUARINGS) };
+
+        // s = e^r - 1, kept without the leading 1 so squaring does not cancel
+        DoubleDouble term = r;
+        DoubleDouble s = r;
+        for (int i = 2; i <= TERMS; ++i) {
+            term = term * r / DoubleDouble(static_cast<double>(i));
+            s = s + term;
+        }
+        for (int i = 0; i < SQUARINGS; ++i) {
+            s = s * 2.0 + s * s; // (1 + s)^2 - 1
+        }
+        s = s + DoubleDouble(1.0);
+
+        const int e = static_cast<int>(k);
+        return { std::ldexp(s.hi, e), std::ldexp(s.lo, e) };
+    }
+
+    inline DoubleDouble log(DoubleDouble x) noexcept {
+        if (!(x.hi > 0.0)) return { std::numeric_limits<double>::quiet_NaN(), 0.0 };
+
+        const DoubleDouble y(std::log(x.hi));
+        return y + x * exp(-y) - DoubleDouble(1.0);
+    }
+
+    inline double reduceTwoPi(DoubleDouble x) noexcept {
+        const double k = std::nearbyint(x.hi / DD::TWO_PI.hi);
+        const DoubleDouble r = x - DD::TWO_PI * k;
+        return r.hi + r.lo;
+    }
+
+}
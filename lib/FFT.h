@@ -0,0 +1,55 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+#include <span>
+#include <concepts>
+
+namespace Zeta {
+
+    /**
+     * @namespace FFT
+     * @brief Fast Fourier transforms used by the block (multi-evaluation) engines.
+     */
+    namespace FFT {
+
+        /**
+         * @brief Smallest power of two that is $ \geq n $.
+         */
+        [[nodiscard]]
+        constexpr int nextPow2(int n) noexcept;
+
+        /**
+         * @brief In-place radix-2 Cooley-Tukey transform.
+         * Computes
+         * $$ X_k = \sum_{m=0}^{M-1} x_m \, e^{\mp 2\pi i k m / M} $$
+         * with the minus sign for the forward transform. No $ 1/M $ scaling is applied.
+         * @tparam T Floating point type (float, double, long double).
+         * @param data Samples; the size must be a power of two.
+         * @param inverse Use the $ e^{+2\pi i k m / M} $ kernel.
+         */
+        template <std::floating_point T>
+        void fft(std::vector<std::complex<T>>& data, bool inverse = false);
+
+        /**
+         * @brief Non-uniform FFT (type 1): arbitrary nodes, equispaced modes.
+         * Computes
+         * $$ F_j = \sum_{n} c_n \, e^{-i j x_n}, \qquad j = 0, \dots, M-1 $$
+         * in $ O(n \cdot w + M \log M) $ via Gaussian gridding onto an oversampled
+         * periodic grid followed by an FFT and deconvolution (Greengard-Lee).
+         * The spreading width $ w $ gives roughly 12 significant digits.
+         * @param coeffs The weights $ c_n $.
+         * @param nodes The nodes $ x_n $ (any real value, taken modulo $ 2\pi $).
+         * @param modes The number of output modes $ M $.
+         * @return The values $ F_0, \dots, F_{M-1} $.
+         */
+        template <std::floating_point T>
+        [[nodiscard]]
+        std::vector<std::complex<T>> nufft(std::span<const std::complex<T>> coeffs,
+                                           std::span<const T> nodes,
+                                           int modes);
+
+    }
+}
+
+#include "FFT.tpp"
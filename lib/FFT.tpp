@@ -0,0 +1,128 @@
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <numbers>
+#include <ranges>
+#include <algorithm>
+#include <utility>
+
+namespace Zeta::FFT {
+
+    constexpr int nextPow2(int n) noexcept {
+        int p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    template <std::floating_point T>
+    void fft(std::vector<std::complex<T>>& data, bool inverse) {
+        constexpr T PI = std::numbers::pi_v<T>;
+        const int M = static_cast<int>(data.size());
+        if (M < 2) return;
+
+        // Bit-reversal permutation
+        for (int i = 1, j = 0; i < M; ++i) {
+            int bit = M >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(data[i], data[j]);
+        }
+
+        // Twiddles are computed directly (not by recurrence) to keep the error at O(eps log M)
+        const T sign = inverse ? T{1} : T{-1};
+        std::vector<std::complex<T>> twiddle(M / 2);
+        std::ranges::for_each(
+            std::views::iota(0, M / 2),
+            [&twiddle, sign, M](int k) {
+                twiddle[k] = std::polar(T{1}, sign * T{2} * PI * static_cast<T>(k) / static_cast<T>(M));
+            }
+        );
+
+        for (int len = 2; len <= M; len <<= 1) {
+            const int half = len / 2;
+            const int stride = M / len;
+            for (int i = 0; i < M; i += len) {
+                for (int k = 0; k < half; ++k) {
+                    std::complex<T> u = data[i + k];
+                    std::complex<T> v = data[i + k + half] * twiddle[k * stride];
+                    data[i + k]        = u + v;
+                    data[i + k + half] = u - v;
+                }
+            }
+        }
+    }
+
+    template <std::floating_point T>
+    std::vector<std::complex<T>> nufft(std::span<const std::complex<T>> coeffs,
+                                       std::span<const T> nodes,
+                                       int modes) {
+        constexpr T PI = std::numbers::pi_v<T>;
+        constexpr T TWO_PI = T{2} * PI;
+        constexpr int SPREAD = 12;
+
+        if (modes <= 0) return {};
+
+        // Oversampled grid (ratio R >= 2) and the matching Gaussian width tau
+        const int Mr = nextPow2(std::max(2 * modes, 2 * SPREAD));
+        const T R = static_cast<T>(Mr) / static_cast<T>(modes);
+        const T M_sq = static_cast<T>(modes) * static_cast<T>(modes);
+        const T tau = PI * static_cast<T>(SPREAD) / (M_sq * R * (R - T{0.5}));
+        const T h = TWO_PI / static_cast<T>(Mr);
+
+        // Output modes are shifted to k = j - half so that |k| <= M/2 in the deconvolution
+        const int half = modes / 2;
+
+        std::vector<T> E3(SPREAD + 1);
+        std::ranges::for_each(
+            std::views::iota(0, SPREAD + 1),
+            [&E3, tau, Mr](int l) {
+                T a = PI * static_cast<T>(l) / static_cast<T>(Mr);
+                E3[l] = std::exp(-(a * a) / tau);
+            }
+        );
+
+        // Fast Gaussian gridding: two exponentials per node, the rest by recurrence
+        std::vector<std::complex<T>> grid(Mr, std::complex<T>{0, 0});
+        const std::size_t count = std::min(coeffs.size(), nodes.size());
+
+        for (std::size_t n = 0; n < count; ++n) {
+            T x = std::fmod(nodes[n], TWO_PI);
+            if (x < T{0}) x += TWO_PI;
+
+            int m0 = static_cast<int>(x / h);
+            if (m0 >= Mr) m0 = Mr - 1;
+            const T diff = x - static_cast<T>(m0) * h;
+
+            const T E1 = std::exp(-(diff * diff) / (T{4} * tau));
+            const T E2 = std::exp(diff * PI / (static_cast<T>(Mr) * tau));
+            const std::complex<T> v = coeffs[n] * std::polar(E1, -static_cast<T>(half) * x);
+
+            T E2_pow = T{1};
+            for (int l = 0; l <= SPREAD; ++l) {
+                grid[(m0 + l) % Mr] += v * (E2_pow * E3[l]);
+                E2_pow *= E2;
+            }
+
+            const T E2_inv = T{1} / E2;
+            E2_pow = E2_inv;
+            for (int l = 1; l < SPREAD; ++l) {
+                grid[(m0 - l + Mr) % Mr] += v * (E2_pow * E3[l]);
+                E2_pow *= E2_inv;
+            }
+        }
+
+        fft(grid);
+
+        // Deconvolve the Gaussian: F(k) = sqrt(pi/tau) e^{k^2 tau} G(k) / Mr
+        const T scale = std::sqrt(PI / tau) / static_cast<T>(Mr);
+
+        return std::views::iota(0, modes)
+            | std::views::transform([&grid, scale, tau, half, Mr](int j) {
+                const int k = j - half;
+                const T kk = static_cast<T>(k);
+                return grid[(k + Mr) % Mr] * (scale * std::exp(kk * kk * tau));
+            })
+            | std::ranges::to<std::vector<std::complex<T>>>();
+    }
+
+}
@@ -0,0 +1,166 @@
+#include "FrameSink.h"
+#include "Profile.h"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+
+// =====================================================================
+// PpmFileSink
+// =====================================================================
+
+PpmFileSink::PpmFileSink(const std::string& folder) : folder(folder) {}
+
+void PpmFileSink::write_frame(const unsigned char* rgb, int width, int height, int index) {
+    std::stringstream ss;
+    ss << folder << "/frame_" << std::setfill('0') << std::setw(4) << index << ".ppm";
+
+    std::ofstream file(ss.str(), std::ios::binary);
+    if (!file) { std::cerr << "Error opening " << ss.str() << std::endl; return; }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(rgb), static_cast<std::streamsize>(width) * height * 3);
+    ZETA_COUNT(BytesWritten, static_cast<std::size_t>(width) * height * 3);
+}
+
+// =====================================================================
+// StreamSink
+// =====================================================================
+
+StreamSink::StreamSink(std::FILE* out, bool is_pipe, Format format, int fps)
+    : out(out), is_pipe(is_pipe), format(format), fps(std::max(fps, 1)) {}
+
+std::unique_ptr<StreamSink> StreamSink::to_file(const std::string& path, Format format, int fps) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) std::cerr << "Error opening " << path << std::endl;
+    return std::unique_ptr<StreamSink>(new StreamSink(f, false, format, fps));
+}
+
+std::unique_ptr<StreamSink> StreamSink::to_fd(int fd, Format format, int fps) {
+    std::FILE* f = fdopen(fd, "wb");
+    if (!f) std::cerr << "Error opening descriptor " << fd << std::endl;
+    return std::unique_ptr<StreamSink>(new StreamSink(f, false, format, fps));
+}
+
+std::unique_ptr<StreamSink> StreamSink::to_encoder(const std::string& command, Format format, int fps) {
+    std::FILE* f = popen(command.c_str(), "w");
+    if (!f) std::cerr << "Error starting " << command << std::endl;
+    return std::unique_ptr<StreamSink>(new StreamSink(f, true, format, fps));
+}
+
+StreamSink::~StreamSink() {
+    finish();
+}
+
+void StreamSink::write_frame(const unsigned char* rgb, int width, int height, int index) {
+    if (!out) return;
+
+    const std::size_t pixel_count = static_cast<std::size_t>(width) * height;
+
+    if (format == Format::RawRGB) {
+        std::fwrite(rgb, 1, pixel_count * 3, out);
+        ZETA_COUNT(BytesWritten, pixel_count * 3);
+        return;
+    }
+
+    if (!header_written) {
+        std::fprintf(out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, fps);
+        header_written = true;
+    }
+
+    // BT.601 limited range, fixed point (coefficients scaled by 256)
+    planes.resize(pixel_count * 3);
+    unsigned char* y_plane = planes.data();
+    unsigned char* u_plane = y_plane + pixel_count;
+    unsigned char* v_plane = u_plane + pixel_count;
+    for (std::size_t i = 0; i < pixel_count; ++i) {
+        const int r = rgb[3 * i], g = rgb[3 * i + 1], b = rgb[3 * i + 2];
+        y_plane[i] = static_cast<unsigned char>((( 66 * r + 129 * g +  25 * b + 128) >> 8) +  16);
+        u_plane[i] = static_cast<unsigned char>(((-38 * r -  74 * g + 112 * b + 128) >> 8) + 128);
+        v_plane[i] = static_cast<unsigned char>(((112 * r -  94 * g -  18 * b + 128) >> 8) + 128);
+    }
+
+    std::fputs("FRAME\n", out);
+    std::fwrite(planes.data(), 1, planes.size(), out);
+    ZETA_COUNT(BytesWritten, planes.size() + 6);
+    (void)index;
+}
+
+void StreamSink::finish() {
+    if (!out) return;
+    if (is_pipe) {
+        const int status = pclose(out);
+        if (status != 0) std::cerr << "Encoder exited with status " << status << std::endl;
+    } else {
+        std::fclose(out);
+    }
+    out = nullptr;
+}
+
+// =====================================================================
+// AsyncSink
+// =====================================================================
+
+AsyncSink::AsyncSink(std::unique_ptr<FrameSink> target, int depth)
+    : target(std::move(target)), slots(std::max(depth, 2)), writer([this] { writer_loop(); }) {}
+
+AsyncSink::~AsyncSink() {
+    finish();
+}
+
+void AsyncSink::write_frame(const unsigned char* rgb, int width, int height, int index) {
+    write_delta(rgb, width, height, index, DirtyRect{ 0, 0, width, height });
+}
+
+void AsyncSink::write_delta(const unsigned char* rgb, int width, int height, int index, const DirtyRect& dirty) {
+    std::unique_lock lock(mutex);
+    if (stopping) return;
+    slot_freed.wait(lock, [this] { return !slots[fill_slot].full; });
+
+    // The writer never touches a slot that is not full, so the copy can run unlocked
+    Slot& slot = slots[fill_slot];
+    lock.unlock();
+
+    slot.rgb.assign(rgb, rgb + static_cast<std::size_t>(width) * height * 3);
+    slot.width = width;
+    slot.height = height;
+    slot.index = index;
+    slot.dirty = dirty;
+
+    lock.lock();
+    slot.full = true;
+    fill_slot = (fill_slot + 1) % static_cast<int>(slots.size());
+    lock.unlock();
+    slot_filled.notify_one();
+}
+
+void AsyncSink::writer_loop() {
+    while (true) {
+        std::unique_lock lock(mutex);
+        slot_filled.wait(lock, [this] { return slots[drain_slot].full || stopping; });
+        if (!slots[drain_slot].full) return; // stopping with nothing left
+
+        Slot& slot = slots[drain_slot];
+        lock.unlock();
+
+        target->write_delta(slot.rgb.data(), slot.width, slot.height, slot.index, slot.dirty);
+
+        lock.lock();
+        slot.full = false;
+        drain_slot = (drain_slot + 1) % static_cast<int>(slots.size());
+        lock.unlock();
+        slot_freed.notify_one();
+    }
+}
+
+void AsyncSink::finish() {
+    {
+        std::lock_guard lock(mutex);
+        if (stopping) return;
+        stopping = true;
+    }
+    slot_filled.notify_one();
+    writer.join();
+    target->finish();
+}
@@ -0,0 +1,125 @@
+#ifndef FRAME_SINK_H
+#define FRAME_SINK_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Half-open pixel rectangle [x0, x1) x [y0, y1).
+struct DirtyRect {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+
+    bool empty() const { return x1 <= x0 || y1 <= y0; }
+
+    void include(int x, int y) {
+        if (empty()) { x0 = x; y0 = y; x1 = x + 1; y1 = y + 1; return; }
+        x0 = std::min(x0, x); y0 = std::min(y0, y);
+        x1 = std::max(x1, x + 1); y1 = std::max(y1, y + 1);
+    }
+};
+
+// Destination for the RGB24 frames produced by PlotCanvas animations.
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+
+    // `rgb` holds width * height * 3 bytes, rows top to bottom. The sink must not keep the pointer.
+    virtual void write_frame(const unsigned char* rgb, int width, int height, int index) = 0;
+
+    // Same frame, plus the box of pixels that changed since the previous one.
+    // Sinks that store whole frames ignore the box.
+    virtual void write_delta(const unsigned char* rgb, int width, int height, int index, const DirtyRect& dirty) {
+        (void)dirty;
+        write_frame(rgb, width, height, index);
+    }
+
+    // Flushes and closes the destination; further frames are dropped. Called by the destructor too.
+    virtual void finish() {}
+};
+
+// One binary PPM file per frame: <folder>/frame_%04d.ppm (the original output mode).
+class PpmFileSink : public FrameSink {
+private:
+    std::string folder;
+
+public:
+    explicit PpmFileSink(const std::string& folder);
+
+    void write_frame(const unsigned char* rgb, int width, int height, int index) override;
+};
+
+// All frames as one stream, to a file, an inherited descriptor, or the stdin of an encoder process.
+class StreamSink : public FrameSink {
+public:
+    enum class Format {
+        RawRGB, // bare rgb24 frames (ffmpeg: -f rawvideo -pix_fmt rgb24 -s WxH -r FPS -i -)
+        Y4M     // YUV4MPEG2, 4:4:4 BT.601; self-describing (ffmpeg: -i -)
+    };
+
+    static std::unique_ptr<StreamSink> to_file(const std::string& path, Format format, int fps);
+    // Takes ownership of `fd`.
+    static std::unique_ptr<StreamSink> to_fd(int fd, Format format, int fps);
+    // Runs `command` through popen and writes the stream to its stdin, e.g.
+    // "ffmpeg -y -i - -c:v libx264 -pix_fmt yuv420p out.mp4" for Format::Y4M.
+    static std::unique_ptr<StreamSink> to_encoder(const std::string& command, Format format, int fps);
+
+    ~StreamSink() override;
+
+    void write_frame(const unsigned char* rgb, int width, int height, int index) override;
+    void finish() override;
+
+    bool ok() const { return out != nullptr; }
+
+private:
+    StreamSink(std::FILE* out, bool is_pipe, Format format, int fps);
+
+    std::FILE* out;
+    bool is_pipe;
+    Format format;
+    int fps;
+    bool header_written = false;
+    std::vector<unsigned char> planes; // Y4M conversion scratch
+};
+
+// Hands frames to a writer thread through a ring of `depth` buffers (at least two), so the renderer
+// only pays for a copy. The renderer blocks only when the writer is `depth` frames behind; a deeper
+// ring absorbs bursts, e.g. while other sinks' writers compete for the disk or the encoder.
+class AsyncSink : public FrameSink {
+public:
+    explicit AsyncSink(std::unique_ptr<FrameSink> target, int depth = 2);
+    ~AsyncSink() override;
+
+    void write_frame(const unsigned char* rgb, int width, int height, int index) override;
+    void write_delta(const unsigned char* rgb, int width, int height, int index, const DirtyRect& dirty) override;
+    void finish() override;
+
+private:
+    struct Slot {
+        std::vector<unsigned char> rgb;
+        int width = 0;
+        int height = 0;
+        int index = 0;
+        DirtyRect dirty;
+        bool full = false;
+    };
+
+    void writer_loop();
+
+    std::unique_ptr<FrameSink> target;
+    std::vector<Slot> slots;
+    int fill_slot = 0;   // next slot the renderer fills
+    int drain_slot = 0;  // next slot the writer drains
+    bool stopping = false;
+
+    std::mutex mutex;
+    std::condition_variable slot_freed;
+    std::condition_variable slot_filled;
+    std::thread writer;
+};
+
+#endif
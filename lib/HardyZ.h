@@ -1,18 +1,30 @@
 #pragma once
 
+#include <array>
 #include <complex>
 #include <vector>
+#include <span>
+#include <optional>
 #include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include "RSCoefficients.h"
+#include "Bernoulli.h"
+#include "DoubleDouble.h"
+#include "Theta.h"
 
 namespace Zeta {
 
+    namespace Parallel { class WorkStealingPool; }
+
     /**
      * @brief Methods available for computing the Hardy Z function.
      */
     enum class Method {
         /**
          * @brief Euler-Maclaurin Summation.
-         * * **Complexity:** $ O(t) $
+         * * **Complexity:** $ O(t) $, with $ N $ and the number of Bernoulli terms chosen per call
+         *   for the cheapest evaluation meeting Options::em_tolerance ($ N \approx t/2\pi $ or below).
          * * **Precision:** High (uses Bernoulli correction terms).
          * * **Use Case:** Recommended for $ t < 10,000 $ or high accuracy checks.
          */
@@ -26,15 +38,53 @@ namespace Zeta {
          */
         RiemannSiegel,
 
+        /**
+         * @brief Riemann-Siegel Formula with the $ C_0, \dots, C_4 $ remainder series.
+         * * **Complexity:** $ O(\sqrt{t}) $
+         * * **Precision:** High; the error after $ C_k $ is $ O(t^{-(2k+3)/4}) $ (about $ 10^{-12} $ at $ t = 10^4 $ with all terms).
+         * * **Use Case:** Drop-in replacement for EulerMaclaurin once $ t \gtrsim 200 $.
+         */
+        RiemannSiegelRemainder,
+
         /**
          * @brief Odlyzko-Schönhage Algorithm.
-         * * **Complexity:** $ O(t^{1/3}) $ (amortized over a block).
-         * * **Precision:** High.
+         * * **Complexity:** $ O(\sqrt{t} + M \log M) $ for a block of $ M $ points,
+         *   i.e. $ O(\log M) $ amortized per point once $ M \gtrsim \sqrt{t} $.
+         * * **Precision:** Same as the Riemann-Siegel main sum (up to ~12 digits lost in the NUFFT).
          * * **Use Case:** Only efficient when computing **blocks** of zeros for extremely large $ t $.
          */
         OdlyzkoSchonhage
     };
 
+    /**
+     * @brief Tuning knobs shared by Hardy::compute and Hardy::computeBlock.
+     */
+    struct Options {
+        /**
+         * @brief Highest remainder term $ C_k $ used by Method::RiemannSiegelRemainder.
+         * Clamped to [-1, RS_MAX_ORDER]; -1 reduces to the main sum.
+         */
+        int rs_order = RS_MAX_ORDER;
+
+        /**
+         * @brief Target absolute error of $ \zeta(\frac{1}{2} + it) $ for Method::EulerMaclaurin.
+         * Values below the working precision of T are raised to $ 16 \varepsilon $.
+         */
+        double em_tolerance = 1e-10;
+
+        /**
+         * @brief Worker threads used by Hardy::computeBlock (<= 0: all hardware threads, 1: sequential).
+         * The output does not depend on this value.
+         */
+        int threads = 0;
+
+        /**
+         * @brief Pool to run on instead of Parallel::sharedPool(threads); its size replaces `threads`.
+         * A pool runs one parallelFor at a time, so callers evaluating concurrently each pass their own.
+         */
+        Parallel::WorkStealingPool* pool = nullptr;
+    };
+
     /**
      * @namespace Hardy
      * @brief Functions for computing the Hardy Z-function on the critical line.
@@ -51,47 +101,231 @@ namespace Zeta {
          * @tparam T Floating point type (float, double, long double).
          * @param t The imaginary component of the argument.
          * @param method The algorithm to use (default: EulerMaclaurin).
+         * @param options Method-specific settings.
          * @return The real value $ Z(t) $.
          */
         template <std::floating_point T>
         [[nodiscard]]
-        T compute(T t, Method method = Method::EulerMaclaurin);
+        T compute(T t, Method method = Method::EulerMaclaurin, const Options& options = {});
+
+        /**
+         * @brief Computes Z(t) with the method fixed at compile time, e.g. `compute<Method::RiemannSiegel>(t)`.
+         * * Same values as compute(t, M, options); the runtime overload dispatches here.
+         * * Each instantiation inlines its kernel without the method switch, for callers that evaluate
+         *   many points with one method. Method::OdlyzkoSchonhage works on grids only (computeBlock).
+         */
+        template <Method M, std::floating_point T>
+        [[nodiscard]]
+        T compute(T t, const Options& options = {});
 
         /**
          * @brief Computes a range of Z values efficiently.
          * * Primary entry point for Odlyzko-Schönhage blocks.
+         * * The grid is cut into fixed-size chunks (detail::blockChunk) that a work-stealing pool
+         *   of Options::threads workers evaluates; results are written in grid order.
          * @param start_t The starting height.
          * @param length The length of the interval.
          * @param points The number of sampling points.
          * @param method Algorithm (default: OdlyzkoSchonhage).
+         * @param options Method-specific settings.
          * @return A vector containing the Z values.
          */
         template <std::floating_point T>
         [[nodiscard]]
-        std::vector<T> computeBlock(T start_t, T length, int points, Method method = Method::OdlyzkoSchonhage);
+        std::vector<T> computeBlock(T start_t, T length, int points,
+                                    Method method = Method::OdlyzkoSchonhage, const Options& options = {});
+
+        /**
+         * @brief Computes Z on the grid indices [first, first + out.size()) of $ t_k = t_0 + k h $.
+         * * computeBlock is computeGrid over [0, points) with $ h = length / (points - 1) $.
+         * * Chunks are aligned to multiples of detail::blockChunk over the whole grid, so a grid computed
+         *   in chunk-aligned pieces (e.g. by Zeta::Shards) matches one computeBlock call bit for bit.
+         * @param step The grid spacing $ h $.
+         * @param first Index of the first point.
+         * @param out Receives $ Z(t_k) $ at out[k - first].
+         */
+        template <std::floating_point T>
+        void computeGrid(T start_t, T step, std::int64_t first, std::span<T> out,
+                         Method method = Method::OdlyzkoSchonhage, const Options& options = {});
+
+        /**
+         * @brief Default number of rotation steps between exact re-synchronizations of EMSampler.
+         */
+        inline constexpr int EM_RESYNC_INTERVAL = 256;
+
+        /**
+         * @brief Streaming Euler-Maclaurin evaluator on an arithmetic grid $ t_k = t_0 + k h $.
+         * Keeps the phasors $ n^{-s} = n^{-1/2} e^{-i t_k \ln n} $ and advances them by the fixed
+         * rotations $ n^{-ih} $, so each sample costs $ N $ complex multiply-adds instead of $ N $ calls
+         * to `std::pow`. Every `resync_every` steps the phasors are rebuilt exactly to bound drift.
+         * The cutoff $ N $ is fixed from the largest $ |t_k| $ in the grid.
+         * @tparam T Floating point type (float, double, long double).
+         */
+        template <std::floating_point T>
+        class EMSampler {
+        public:
+            /**
+             * @brief One grid sample.
+             */
+            struct Value {
+                T t;
+                T theta;
+                std::complex<T> zeta; ///< $ \zeta(\frac{1}{2} + it) $
+                T z;                  ///< $ Z(t) $
+            };
+
+            /**
+             * @param start_t The first height $ t_0 $.
+             * @param step The grid spacing $ h $.
+             * @param count The number of samples the stream will produce (fixes $ N $).
+             * @param tolerance Target absolute error, as Options::em_tolerance.
+             * @param resync_every Steps between exact phasor rebuilds.
+             */
+            EMSampler(T start_t, T step, int count, double tolerance = Options{}.em_tolerance,
+                      int resync_every = EM_RESYNC_INTERVAL);
+
+            /**
+             * @brief Restarts the stream at a new $ t_0 $ with the same spacing, reusing the buffers.
+             * $ N $ and $ m $ are chosen again for the new grid.
+             */
+            void restart(T start_t, int count);
+
+            /**
+             * @brief Evaluates the current grid point and advances to the next one.
+             */
+            [[nodiscard]]
+            Value next();
+
+            /**
+             * @brief Index $ k $ of the grid point returned by the next call to next().
+             */
+            [[nodiscard]]
+            int index() const noexcept { return k; }
+
+        private:
+            void resync();
+
+            T start_t;
+            T step;
+            double tolerance;
+            int N;
+            int m;
+            int resync_every;
+            int k = 0;
+
+            // SoA phasors n^{-s} and rotations n^{-ih}, n = 1..N
+            std::vector<T> phasor_re, phasor_im;
+            std::vector<T> rotor_re, rotor_im;
+
+            // theta(t_k) for Value::theta, and modulo 2 pi for the rotation of zeta
+            ThetaExpansion<T> theta_value;
+            ThetaExpansion<T> theta_reduced{ true };
+        };
 
         namespace detail {
+
+            /**
+             * @brief Largest number of Bernoulli correction terms considered by chooseEM.
+             */
+            inline constexpr int EM_MAX_TERMS = 60;
+
+            /**
+             * @brief The Euler-Maclaurin weights $ \frac{B_{2k}}{(2k)!} $, k = 0 .. EM_MAX_TERMS + 1
+             * (the last one bounds the first omitted term in chooseEM), divided out in long double at compile time.
+             */
+            template <std::floating_point T>
+            inline constexpr std::array<T, EM_MAX_TERMS + 2> EM_CORRECTION = [] {
+                std::array<T, EM_MAX_TERMS + 2> weights{};
+                long double factorial = 1.0L;
+                for (int k = 0; k < EM_MAX_TERMS + 2; ++k) {
+                    if (k > 0) factorial *= static_cast<long double>((2 * k - 1) * (2 * k));
+                    weights[k] = static_cast<T>(Zeta::bernoulli<long double>(2 * k) / factorial);
+                }
+                return weights;
+            }();
+
+            /**
+             * @brief Euler-Maclaurin parameters: summation cutoff and number of correction terms.
+             */
+            struct EMParams {
+                int N;
+                int m;
+            };
+
+            /**
+             * @brief Picks the cheapest $ (N, m) $ whose remainder bound meets the tolerance.
+             * For each $ m $ the bound on the first omitted term
+             * $$
+             * |R_m| \leq \frac{|B_{2m+2}|}{(2m+2)!} \left| \prod_{j=0}^{2m} (s+j) \right| \frac{|s+2m+1|}{\sigma+2m+1} N^{-\sigma-2m-1}
+             * $$
+             * is solved for the smallest $ N $, and the $ m $ minimizing $ N + m $ is kept.
+             * The product is extended incrementally and the search stops once the cost rises.
+             * @param s The complex argument.
+             * @param tolerance Target absolute error of $ \zeta(s) $.
+             */
+            template <std::floating_point T>
+            EMParams chooseEM(std::complex<T> s, double tolerance);
             
         /**
              * @brief Helper for computeEM to calculate the complex Zeta value.
              * Computes $ \zeta(s) $ via:
              * $$
-             * \zeta(s) \approx \sum_{n=1}^{N-1} n^{-s} + \frac{N^{1-s}}{s-1} + \frac{1}{2}N^{-s} + \sum_{k=1}^{m} \frac{B_{2k}}{(2k)!} f^{(2k-1)}(N)
+             * \zeta(s) \approx \sum_{n=1}^{N-1} n^{-s} + \frac{N^{1-s}}{s-1} + \frac{1}{2}N^{-s} - \sum_{k=1}^{m} \frac{B_{2k}}{(2k)!} f^{(2k-1)}(N)
              * $$
+             * where $ f(x) = x^{-s} $.
              * @param s The complex argument $ \frac{1}{2} + it $.
              * @param N The summation cutoff limit.
+             * @param m The number of Bernoulli correction terms.
              */
             template <std::floating_point T>
-            std::complex<T> zetaEM(std::complex<T> s, int N);
+            std::complex<T> zetaEM(std::complex<T> s, int N, int m);
+
+            /**
+             * @brief Euler-Maclaurin tail of zetaEM: everything after the partial sum $ \sum_{n<N} n^{-s} $.
+             * The derivative factors $ (-s)(-s-1)\cdots(-s-2k+2) N^{-s-2k+1} $ are built incrementally.
+             * @param N_pow_minus_s The value $ N^{-s} $ (supplied by the caller, which may already hold it).
+             */
+            template <std::floating_point T>
+            std::complex<T> tailEM(std::complex<T> s, int N, int m, std::complex<T> N_pow_minus_s);
 
 
             /**
              * @brief Computes Z(t) using the Euler-Maclaurin summation for $ \zeta(s) $.
-             * Computes $ \zeta(s) $ via zetaEM 
+             * Computes $ \zeta(s) $ via zetaEM with parameters from chooseEM
              * and rotates the result by $ e^{i\theta(t)} $.
+             * @param tolerance Target absolute error (see Options::em_tolerance).
+             */
+            template <std::floating_point T>
+            T computeEM(T t, double tolerance);
+
+            /**
+             * @brief Height from which double evaluations carry their phases in Zeta::DoubleDouble.
+             * The phases $ \theta(t) - t \ln n $ and $ -t \ln n $ are of size $ t \ln t $, so in double they
+             * lose about $ t \ln t \cdot 2^{-53} $ radians: ~1e-9 at $ 10^6 $ but ~1e-4 at $ 10^{10} $, enough
+             * to merge close zeros. From here on they are formed in double-double and reduced modulo
+             * $ 2\pi $ before the (double) cosine; the sums themselves stay in double.
+             */
+            inline constexpr double PRECISE_PHASE_MIN_T = 1e6;
+
+            /**
+             * @brief $ Z(0) = \zeta(\frac{1}{2}) $ (as $ \theta(0) = 0 $), returned for $ |t| < 10^{-9} $ by every method.
+             */
+            template <std::floating_point T>
+            inline constexpr T Z_AT_ZERO = static_cast<T>(-1.46035450880958681288949915251529801L);
+
+            /**
+             * @brief Type the main-sum phase is carried in: float is promoted to double, like the sum.
              */
             template <std::floating_point T>
-            T computeEM(T t);
+            using PhaseType = std::conditional_t<std::same_as<T, float>, double, T>;
+
+            /**
+             * @brief The grid point $ t_0 + k h $ without rounding, so phases match the rotated sums.
+             */
+            [[nodiscard]]
+            inline DoubleDouble gridPoint(double start_t, double step, int k) noexcept {
+                return DoubleDouble(start_t) + DD::twoProd(static_cast<double>(k), step);
+            }
 
             /**
              * @brief Computes Z(t) using the Riemann-Siegel Main Sum.
@@ -100,17 +334,121 @@ namespace Zeta {
              * $$
              * Z(t) \approx 2 \sum_{n=1}^{\lfloor \sqrt{t/2\pi} \rfloor} \frac{\cos(\theta(t) - t \ln n)}{\sqrt{n}}
              * $$
+             * For float and double the sum runs through Zeta::cosSum (SIMD, in double) over the
+             * shared Zeta::dirichletTable, or Zeta::cosSumPrecise from PRECISE_PHASE_MIN_T on;
+             * other types use the generic scalar fold.
              */
             template <std::floating_point T>
             T computeRS(T t);
 
             /**
-             * @brief Implementation of the rational function expansion / FFT method.
-             * * Uses the Taylor expansion of $ n^{-i\delta} $ to evaluate sums quickly.
+             * @brief computeRS with $ \theta(t) $ supplied, e.g. by a Zeta::ThetaExpansion over a grid.
+             * @param theta $ \theta(t) $, or $ \theta(t) $ modulo $ 2\pi $. From PRECISE_PHASE_MIN_T on it must be
+             *        accurate to ~1e-15 absolute, which in practice means reduced from a double-double value.
+             */
+            template <std::floating_point T>
+            T computeRS(T t, PhaseType<T> theta);
+
+            /**
+             * @brief Riemann-Siegel remainder $ R(t) $ that completes the main sum.
+             * With $ a = \sqrt{t/2\pi} $, $ N = \lfloor a \rfloor $ and $ p = a - N $:
+             * $$
+             * R(t) = (-1)^{N-1} a^{-1/2} \sum_{k=0}^{K} C_k(p) \, a^{-k}
+             * $$
+             * @param order The highest term $ K $ (see Zeta::riemannSiegelC).
+             */
+            template <std::floating_point T>
+            T remainderRS(T t, int order);
+
+            /**
+             * @brief remainderRS for a compile-time order $ K \leq $ RS_MAX_ORDER: the series is unrolled
+             * over constant coefficient tables (Zeta::riemannSiegelC<K>). $ K < 0 $ gives 0.
+             */
+            template <int K, std::floating_point T>
+            T remainderRS(T t);
+
+            /**
+             * @brief Calls body(std::integral_constant<int, K>{}) with K = min(order, RS_MAX_ORDER), or -1 for order < 0,
+             * so a loop inside body sees the remainder order as a constant.
+             */
+            template <typename F>
+            decltype(auto) withRSOrder(int order, F&& body);
+
+            /**
+             * @brief Computes Z(t) as computeRS(t) + remainderRS(t, order).
+             */
+            template <std::floating_point T>
+            T computeRSR(T t, int order);
+
+            /**
+             * @brief Smallest run of points sharing one main-sum length that is sent through the NUFFT.
+             * Shorter runs are cheaper to evaluate point by point with computeRS.
+             */
+            inline constexpr int OS_MIN_BLOCK = 8;
+
+            /**
+             * @brief Multi-evaluation of the Riemann-Siegel main sum on an arithmetic grid.
+             * For $ t_j = t_0 + j h $ the sum is a trigonometric sum with non-uniform frequencies:
+             * $$
+             * F(t_j) = \sum_{n=1}^{N} \frac{e^{-i t_0 \ln n}}{\sqrt{n}} \, e^{-i j (h \ln n)}
+             * $$
+             * which a type-1 NUFFT (Zeta::FFT::nufft) evaluates for all $ j $ at once.
+             * Then $ Z(t_j) = 2 \, \mathrm{Re}\left( e^{i\theta(t_j)} F(t_j) \right) $.
+             * The grid is split wherever $ N = \lfloor \sqrt{t/2\pi} \rfloor $ changes.
              */
             template <std::floating_point T>
             std::vector<T> computeOS(T start_t, T length, int points);
 
+            /**
+             * @brief Per-worker buffers reused across the chunks of one computeBlock call.
+             */
+            template <std::floating_point T>
+            struct BlockScratch {
+                std::optional<EMSampler<T>> sampler;
+                std::vector<std::complex<T>> coeffs;
+                std::vector<T> nodes;
+            };
+
+            /**
+             * @brief Grid points per computeBlock chunk. Fixed (not derived from the thread count)
+             * so the values are the same for every Options::threads.
+             * EM chunks match the sampler resync interval; OS chunks are long enough to amortize the NUFFT.
+             */
+            [[nodiscard]]
+            constexpr int blockChunk(Method method) noexcept {
+                return (method == Method::OdlyzkoSchonhage) ? 4096 : EM_RESYNC_INTERVAL;
+            }
+
+            /**
+             * @brief The method single points are evaluated with where `method` evaluates the grids.
+             * Odlyzko-Schonhage has no pointwise form; grids that are mixed with single points are completed
+             * with the remainder (addRemainderRS), so its counterpart is the Riemann-Siegel sum with remainder.
+             */
+            [[nodiscard]]
+            constexpr Method pointwiseMethod(Method method) noexcept {
+                return (method == Method::OdlyzkoSchonhage) ? Method::RiemannSiegelRemainder : method;
+            }
+
+            /**
+             * @brief Adds remainderRS(t_k, order) to values[k] for $ t_k = t_0 + k h $: an Odlyzko-Schonhage
+             * grid (the main sum) becomes the Riemann-Siegel-remainder values of pointwiseMethod.
+             */
+            template <std::floating_point T>
+            void addRemainderRS(T start_t, T step, std::span<T> values, int order);
+
+            /**
+             * @brief computeOS over grid indices [first, last) of $ t_k = t_0 + k h $, writing results[k - first].
+             */
+            template <std::floating_point T>
+            void computeOS(T start_t, T step, std::int64_t first, std::int64_t last, std::span<T> results, BlockScratch<T>& scratch);
+
+            /**
+             * @brief Evaluates grid indices [first, last) with the given method, writing results[k - first].
+             */
+            template <std::floating_point T>
+            void computeRange(T start_t, T step, std::int64_t first, std::int64_t last, Method method, const Options& options,
+                              std::span<T> results, BlockScratch<T>& scratch);
+
         } 
 
     }
@@ -1,58 +1,129 @@
 #include "Theta.h"  
 #include "Bernoulli.h"  
+#include "FFT.h"
+#include "Dirichlet.h"
+#include "ThreadPool.h"
+#include "Profile.h"
 #include <cmath>
 #include <vector>
 #include <complex>
 #include <numbers>      
 #include <ranges>       
 #include <algorithm>    
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace Zeta::Hardy {
 
     namespace detail {
 
         template <std::floating_point T>
-        std::complex<T> zetaEM(std::complex<T> s, int N) {
+        EMParams chooseEM(std::complex<T> s, double tolerance) {
+            const double tol = std::max(tolerance, 16.0 * static_cast<double>(std::numeric_limits<T>::epsilon()));
+            const std::complex<double> s_dbl(static_cast<double>(s.real()), static_cast<double>(s.imag()));
+            const double sigma = s_dbl.real();
+            const double log_tol = std::log(tol);
+            const double log_N_max = std::log(static_cast<double>(std::numeric_limits<int>::max() / 2));
+
+            EMParams best{ std::max(static_cast<int>(std::abs(s_dbl.imag())) + 5, 15), EM_MAX_TERMS };
+            double best_cost = std::numeric_limits<double>::infinity();
+
+            // log of |s (s+1) ... (s+2m)|, extended by two factors per m
+            double log_prod = std::log(std::abs(s_dbl));
+
+            for (int m = 1; m <= EM_MAX_TERMS; ++m) {
+                log_prod += std::log(std::abs(s_dbl + static_cast<double>(2 * m - 1)))
+                          + std::log(std::abs(s_dbl + static_cast<double>(2 * m)));
+
+                // Bound on the first omitted term T_{m+1}, times |s+2m+1| / (sigma+2m+1)
+                const double exponent = sigma + static_cast<double>(2 * m + 1);
+                const double log_A = std::log(std::abs(EM_CORRECTION<double>[m + 1]))
+                                   + log_prod
+                                   + std::log(std::abs(s_dbl + static_cast<double>(2 * m + 1)))
+                                   - std::log(exponent);
+
+                const double log_N = (log_A - log_tol) / exponent;
+                if (!(log_N < log_N_max)) continue;
+
+                const int N = std::max(2, static_cast<int>(std::ceil(std::exp(log_N))));
+                const double cost = static_cast<double>(N) + static_cast<double>(m);
+
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best = { N, m };
+                } else if (m > best.m + 4) {
+                    break; // the cost is convex in m; it has started rising
+                }
+            }
+
+            return best;
+        }
+
+        template <std::floating_point T>
+        std::complex<T> zetaEM(std::complex<T> s, int N, int m) {
             if (N <= 1) return { T{0}, T{0} };
 
-            auto range = std::views::iota(1, N);
+            std::complex<T> sum;
+            {
+                ZETA_TIMED(DirichletSum);
+                ZETA_COUNT(TermsSummed, N - 1);
+                ZETA_COUNT(TranscendentalCalls, N);
+
+                auto range = std::views::iota(1, N);
             
-            std::complex<T> sum = std::ranges::fold_left(
-                range,
-                std::complex<T>{0, 0},
-                [s](std::complex<T> acc, int n) {
-                    return acc + std::pow(static_cast<T>(n), -s);
-                }
-            );
+                sum = std::ranges::fold_left(
+                    range,
+                    std::complex<T>{0, 0},
+                    [s](std::complex<T> acc, int n) {
+                        return acc + std::pow(static_cast<T>(n), -s);
+                    }
+                );
+            }
+
+            return sum + tailEM(s, N, m, std::pow(static_cast<T>(N), -s));
+        }
+
+        template <std::floating_point T>
+        std::complex<T> tailEM(std::complex<T> s, int N, int m, std::complex<T> N_pow_minus_s) {
+            ZETA_TIMED(BernoulliCorrection);
 
             const T N_dbl = static_cast<T>(N);
-            const std::complex<T> N_pow_minus_s = std::pow(N_dbl, -s);
             const T inv_N = T{1} / N_dbl;
             const T inv_N_sq = inv_N * inv_N;
 
             std::complex<T> term_integral = (N_dbl * N_pow_minus_s) / (s - T{1});
             std::complex<T> term_half     = T{0.5} * N_pow_minus_s;
 
-            T Bern2 = Zeta::bernoulli<T>(2);
-            T Bern4 = Zeta::bernoulli<T>(4);
+            // f^{(2k-1)}(N) = (-s)(-s-1)...(-s-2k+2) N^{-s-2k+1}, advanced two factors per k.
+            // It grows like (|s|/N)^{2k} before B_{2k}/(2k)! damps it, so float works in double here.
+            using W = std::conditional_t<std::same_as<T, float>, double, T>;
+            const std::complex<W> s_w(s);
+            const W inv_N_sq_w = static_cast<W>(inv_N_sq);
 
-            std::complex<T> term_B2 = (Bern2 / T{2}) * (-s) * (N_pow_minus_s * inv_N);
-            
-            std::complex<T> term_B4 = (Bern4 / T{24}) 
-                                    * (-s) * (-s - T{1}) * (-s - T{2}) 
-                                    * (N_pow_minus_s * inv_N * inv_N_sq);
+            std::complex<W> derivative = -s_w * std::complex<W>(N_pow_minus_s * inv_N);
+            std::complex<W> correction{0, 0};
+            const std::array<W, EM_MAX_TERMS + 2>& coeffs = EM_CORRECTION<W>;
 
-            return sum + term_integral + term_half + term_B2 + term_B4;
+            for (int k = 1; k <= m; ++k) {
+                correction += coeffs[k] * derivative;
+                derivative *= (-s_w - static_cast<W>(2 * k - 1)) * (-s_w - static_cast<W>(2 * k)) * inv_N_sq_w;
+            }
+
+            return term_integral + term_half - std::complex<T>(correction);
         }
 
         template <std::floating_point T>
-        T computeEM(T t) {
-            const int N = std::max(static_cast<int>(std::abs(t)) + 5, 15);
-
+        T computeEM(T t, double tolerance) {
             std::complex<T> s(T{0.5}, t);
-            std::complex<T> zeta_val = zetaEM(s, N);
+            const EMParams params = chooseEM(s, tolerance);
+            std::complex<T> zeta_val = zetaEM(s, params.N, params.m);
             
-            T theta_val = Zeta::theta<T>(t); 
+            T theta_val;
+            {
+                ZETA_TIMED(Theta);
+                theta_val = Zeta::theta<T>(t);
+            }
 
             std::complex<T> phase(T{0}, theta_val);
             return (std::exp(phase) * zeta_val).real();
@@ -60,12 +131,44 @@ namespace Zeta::Hardy {
 
         template <std::floating_point T>
         T computeRS(T t) {
+            PhaseType<T> theta_val;
+            {
+                ZETA_TIMED(Theta);
+                if constexpr (std::same_as<PhaseType<T>, double>) {
+                    const double t_dbl = static_cast<double>(t);
+                    theta_val = (t_dbl >= PRECISE_PHASE_MIN_T) ? Zeta::reduceTwoPi(Zeta::theta(DoubleDouble(t_dbl)))
+                                                              : Zeta::theta<double>(t_dbl);
+                } else {
+                    theta_val = Zeta::theta<T>(t);
+                }
+            }
+            return computeRS<T>(t, theta_val);
+        }
+
+        template <std::floating_point T>
+        T computeRS(T t, PhaseType<T> theta_val) {
             constexpr T PI = std::numbers::pi_v<T>;
             
             int N = static_cast<int>(std::floor(std::sqrt(t / (T{2} * PI))));
             if (N < 1) return T{0};
 
-            T theta_val = Zeta::theta<T>(t);
+            ZETA_COUNT(TermsSummed, N);
+            ZETA_COUNT(TranscendentalCalls, N);
+            ZETA_TIMED(DirichletSum);
+
+            // float and double share the SIMD kernel; float is promoted so the phase keeps its digits
+            if constexpr (std::same_as<T, double> || std::same_as<T, float>) {
+                const double t_dbl = static_cast<double>(t);
+                const DirichletTable<double>& table = Zeta::dirichletTable<double>(N);
+
+                if (t_dbl >= PRECISE_PHASE_MIN_T) {
+                    return static_cast<T>(2.0 * Zeta::cosSumPrecise(table.log_n.data(), table.log_n_lo.data(),
+                                                                    table.inv_sqrt_n.data(), N,
+                                                                    DoubleDouble(theta_val), t_dbl));
+                }
+                return static_cast<T>(2.0 * Zeta::cosSum(table.log_n.data(), table.inv_sqrt_n.data(), N,
+                                                         theta_val, t_dbl));
+            }
 
             // Formula: Sum[ cos(theta - t*ln(n)) / sqrt(n) ]
             auto range = std::views::iota(1, N + 1);
@@ -83,95 +186,409 @@ namespace Zeta::Hardy {
             return T{2} * sum;
         }
 
+        template <std::floating_point T>
+        T remainderRS(T t, int order) {
+            return withRSOrder(order, [t](auto K) { return remainderRS<decltype(K)::value, T>(t); });
+        }
+
+        template <std::floating_point T>
+        void addRemainderRS(T start_t, T step, std::span<T> values, int order) {
+            withRSOrder(order, [&](auto K) {
+                for (std::size_t k = 0; k < values.size(); ++k) {
+                    values[k] += remainderRS<decltype(K)::value, T>(start_t + static_cast<T>(k) * step);
+                }
+            });
+        }
+
+        template <int K, std::floating_point T>
+        T remainderRS(T t) {
+            constexpr T PI = std::numbers::pi_v<T>;
+            static_assert(K <= RS_MAX_ORDER, "C_k is tabulated up to RS_MAX_ORDER");
+
+            if constexpr (K < 0) {
+                return T{0};
+            } else {
+                const T a = std::sqrt(t / (T{2} * PI));
+                const int N = static_cast<int>(std::floor(a));
+                if (N < 1) return T{0};
+
+                ZETA_TIMED(Remainder);
+
+                const T p = a - static_cast<T>(N);
+                const T inv_a = T{1} / a;
+
+                // Horner in 1/a: C_0 + C_1/a + ... + C_K/a^K, unrolled from C_K down
+                T series = T{0};
+                [&]<int... k>(std::integer_sequence<int, k...>) {
+                    ((series = series * inv_a + Zeta::riemannSiegelC<K - k>(p)), ...);
+                }(std::make_integer_sequence<int, K + 1>{});
+
+                const T sign = (N % 2 == 1) ? T{1} : T{-1}; // (-1)^{N-1}
+                return sign * series / std::sqrt(a);
+            }
+        }
+
+        template <typename F>
+        decltype(auto) withRSOrder(int order, F&& body) {
+            static_assert(RS_MAX_ORDER == 4, "extend the cases below with RS_MAX_ORDER");
+            switch (std::min(order, RS_MAX_ORDER)) {
+                case 0: return body(std::integral_constant<int, 0>{});
+                case 1: return body(std::integral_constant<int, 1>{});
+                case 2: return body(std::integral_constant<int, 2>{});
+                case 3: return body(std::integral_constant<int, 3>{});
+                case 4: return body(std::integral_constant<int, 4>{});
+                default: return body(std::integral_constant<int, -1>{});
+            }
+        }
+
+        template <std::floating_point T>
+        T computeRSR(T t, int order) {
+            return computeRS<T>(t) + remainderRS<T>(t, order);
+        }
+
         template <std::floating_point T>
         std::vector<T> computeOS(T start_t, T length, int points) {
+            if (points <= 0) return {};
+
+            std::vector<T> results(points);
+            const T step = (points > 1) ? (length / static_cast<T>(points - 1)) : T{0};
+            BlockScratch<T> scratch;
+            computeOS<T>(start_t, step, 0, points, results, scratch);
+            return results;
+        }
+
+        template <std::floating_point T>
+        void computeOS(T start_t, T step, std::int64_t first, std::int64_t last, std::span<T> results, BlockScratch<T>& scratch) {
             constexpr T PI = std::numbers::pi_v<T>;
+            constexpr T TWO_PI = T{2} * PI;
+
+            const std::int64_t base = first;
+            const std::int64_t end = last;
+            ZETA_COUNT(Evaluations, end - first);
+
+            // theta modulo 2 pi from one expansion per block of the grid
+            ThetaExpansion<PhaseType<T>> thetas(true);
+
+            // The main-sum length N(t) is piecewise constant; each run of points sharing N is one block
+            while (first < end) {
+                const T t_first = start_t + static_cast<T>(first) * step;
+                int N = static_cast<int>(std::floor(std::sqrt(t_first / TWO_PI)));
+                if (N < 1) N = 1;
+
+                last = end;
+                if (step > T{0}) {
+                    const T t_next = TWO_PI * static_cast<T>(N + 1) * static_cast<T>(N + 1);
+                    const T index_next = std::ceil((t_next - start_t) / step);
+                    if (index_next < static_cast<T>(end)) {
+                        last = std::max(first + 1, static_cast<std::int64_t>(index_next));
+                    }
+                }
+                const int run = static_cast<int>(last - first);
+
+                if (run < OS_MIN_BLOCK) {
+                    std::ranges::for_each(
+                        std::views::iota(first, last),
+                        [&results, &thetas, start_t, step, base](std::int64_t k) {
+                            const T t = start_t + static_cast<T>(k) * step;
+                            results[k - base] = (std::abs(t) < T{1e-9}) ? Z_AT_ZERO<T> : computeRS<T>(t, thetas(t));
+                        }
+                    );
+                    first = last;
+                    continue;
+                }
 
-            std::vector<T> results;
-            results.reserve(points);
+                // F(t_first + j*step) = sum_n c_n e^{-i j x_n} with c_n = n^{-1/2} e^{-i t_first ln n}, x_n = step ln n
+                ZETA_TIMED(NUFFT);
+                ZETA_COUNT(TranscendentalCalls, N + run);
+                const DirichletTable<T>& table = Zeta::dirichletTable<T>(N);
+                std::vector<std::complex<T>>& coeffs = scratch.coeffs;
+                std::vector<T>& nodes = scratch.nodes;
+                coeffs.resize(N);
+                nodes.resize(N);
+
+                const bool precise = std::same_as<T, double> && t_first >= static_cast<T>(PRECISE_PHASE_MIN_T);
+
+                std::ranges::for_each(
+                    std::views::iota(0, N),
+                    [&coeffs, &nodes, &table, t_first, step, precise](int i) {
+                        T phase = -t_first * table.log_n[i];
+                        if constexpr (std::same_as<T, double>) {
+                            if (precise) phase = Zeta::reduceTwoPi(-(DoubleDouble(table.log_n[i], table.log_n_lo[i]) * t_first));
+                        }
+                        coeffs[i] = std::polar(table.inv_sqrt_n[i], phase);
+                        nodes[i] = step * table.log_n[i];
+                    }
+                );
+
+                std::vector<std::complex<T>> sums = Zeta::FFT::nufft<T>(coeffs, nodes, run);
+
+                std::ranges::for_each(
+                    std::views::iota(0, run),
+                    [&results, &sums, &thetas, offset = first - base, t_first, step](int j) {
+                        T theta_val;
+                        {
+                            ZETA_TIMED(Theta);
+                            if constexpr (std::same_as<T, double>) {
+                                // The NUFFT evaluates the unrounded t_first + j h; so does theta
+                                const DoubleDouble t_exact = gridPoint(t_first, step, j);
+                                theta_val = thetas(t_exact.hi, t_exact.lo);
+                            } else {
+                                theta_val = static_cast<T>(thetas(t_first + static_cast<T>(j) * step));
+                            }
+                        }
+                        std::complex<T> rot_phase = std::polar(T{1}, theta_val);
+                        results[offset + j] = (std::abs(t_first + static_cast<T>(j) * step) < T{1e-9})
+                                            ? Z_AT_ZERO<T> : T{2} * (rot_phase * sums[j]).real(); // as compute()
+                    }
+                );
 
-            int N = static_cast<int>(std::floor(std::sqrt(start_t / (T{2} * PI))));
-            if (N < 1) N = 1;
+                first = last;
+            }
+        }
+
+        template <std::floating_point T>
+        void computeRange(T start_t, T step, std::int64_t first, std::int64_t last, Method method, const Options& options,
+                          std::span<T> results, BlockScratch<T>& scratch) {
+            if (method == Method::OdlyzkoSchonhage) {
+                computeOS<T>(start_t, step, first, last, results, scratch);
+                return;
+            }
+
+            if (method == Method::EulerMaclaurin && last - first > 1) {
+                const T chunk_t = start_t + static_cast<T>(first) * step;
+                if (scratch.sampler) {
+                    scratch.sampler->restart(chunk_t, static_cast<int>(last - first));
+                } else {
+                    scratch.sampler.emplace(chunk_t, step, static_cast<int>(last - first), options.em_tolerance);
+                }
+                EMSampler<T>& sampler = *scratch.sampler;
+                std::ranges::for_each(
+                    std::views::iota(first, last),
+                    [&results, &sampler, start_t, step, first](std::int64_t k) {
+                        const T z = sampler.next().z;
+                        results[k - first] = (std::abs(start_t + static_cast<T>(k) * step) < T{1e-9}) ? Z_AT_ZERO<T> : z; // as compute()
+                    }
+                );
+                return;
+            }
+
+            if (method == Method::RiemannSiegel || method == Method::RiemannSiegelRemainder) {
+                // One theta expansion per block of the grid instead of a logarithm per point
+                ThetaExpansion<PhaseType<T>> thetas(true);
+                const int order = (method == Method::RiemannSiegel) ? -1 : options.rs_order;
+                ZETA_COUNT(Evaluations, last - first);
+                withRSOrder(order, [&](auto K) {
+                    std::ranges::for_each(
+                        std::views::iota(first, last),
+                        [&results, &thetas, start_t, step, first](std::int64_t k) {
+                            const T t = start_t + static_cast<T>(k) * step;
+                            if (std::abs(t) < T{1e-9}) { results[k - first] = Z_AT_ZERO<T>; return; } // as compute()
+                            results[k - first] = computeRS<T>(t, thetas(t)) + remainderRS<decltype(K)::value, T>(t);
+                        }
+                    );
+                });
+                return;
+            }
 
-            std::vector<std::complex<T>> base_terms(N + 1);
-            
             std::ranges::for_each(
-                std::views::iota(1, N + 1),
-                [start_t, &base_terms](int n) {
-                    T n_val = static_cast<T>(n);
-                    T ln_n = std::log(n_val);
-                    T mag = T{1} / std::sqrt(n_val);
-                    T phase = -start_t * ln_n;
-                    
-                    base_terms[n] = std::polar(mag, phase);
+                std::views::iota(first, last),
+                [&results, start_t, step, method, &options, first](std::int64_t k) {
+                    results[k - first] = compute<T>(start_t + static_cast<T>(k) * step, method, options);
                 }
             );
+        }
 
-            T step = (points > 1) ? (length / static_cast<T>(points - 1)) : T{0};
-            auto indices = std::views::iota(1, N + 1); 
+    } 
 
-            return std::views::iota(0, points) 
-                    | std::views::transform(
-                    [start_t, step, indices, &base_terms](int k) {
-                        T delta = static_cast<T>(k) * step;
-                        T t_current = start_t + delta;
+    // =====================================================================
+    // EMSampler
+    // =====================================================================
 
-                        T theta_val = Zeta::theta<T>(t_current);
-                        std::complex<T> rot_phase = std::polar(T{1}, theta_val);
+    template <std::floating_point T>
+    EMSampler<T>::EMSampler(T start_t, T step, int count, double tolerance, int resync_every)
+        : start_t(start_t), step(step), tolerance(tolerance), resync_every(std::max(resync_every, 1)) {
+        restart(start_t, count);
+    }
 
-                        std::complex<T> sum = std::ranges::fold_left(
-                            indices,
-                            std::complex<T>{0, 0},
-                            [delta, &base_terms](std::complex<T> acc, int n) {
-                                T ln_n = std::log(static_cast<T>(n));
-                                T perturbation_phase = -delta * ln_n;
-                                
-                                std::complex<T> term = base_terms[n] * std::polar(T{1}, perturbation_phase);
-                                return acc + term;
-                            }
-                        );
+    template <std::floating_point T>
+    void EMSampler<T>::restart(T start_t, int count) {
+        this->start_t = start_t;
+        k = 0;
+
+        // Fresh expansions: their anchors then depend only on this grid, not on earlier restarts
+        theta_value = ThetaExpansion<T>();
+        theta_reduced = ThetaExpansion<T>(true);
+
+        const T last_t = start_t + static_cast<T>(std::max(count - 1, 0)) * step;
+        const T t_max = std::max(std::abs(start_t), std::abs(last_t));
+
+        // The error bound grows with |t|, so parameters chosen at t_max hold for the whole grid
+        const detail::EMParams params = detail::chooseEM(std::complex<T>(T{0.5}, t_max), this->tolerance);
+        N = params.N;
+        m = params.m;
+
+        phasor_re.resize(N);
+        phasor_im.resize(N);
+        rotor_re.resize(N);
+        rotor_im.resize(N);
+
+        const DirichletTable<T>& table = Zeta::dirichletTable<T>(N);
+        ZETA_COUNT(TranscendentalCalls, N);
+        std::ranges::for_each(
+            std::views::iota(0, N),
+            [this, &table](int i) {
+                std::complex<T> r = std::polar(T{1}, -this->step * table.log_n[i]);
+                rotor_re[i] = r.real();
+                rotor_im[i] = r.imag();
+            }
+        );
+
+        resync();
+    }
 
-                        return T{2} * (rot_phase * sum).real();
-                    }
-                ) 
-                | std::ranges::to<std::vector<T>>(); 
+    template <std::floating_point T>
+    void EMSampler<T>::resync() {
+        const T t = start_t + static_cast<T>(k) * step;
+        const DirichletTable<T>& table = Zeta::dirichletTable<T>(N);
+        ZETA_COUNT(TranscendentalCalls, N);
+
+        const bool precise = std::same_as<T, double> && std::abs(t) >= static_cast<T>(detail::PRECISE_PHASE_MIN_T);
+        const DoubleDouble t_dd = detail::gridPoint(static_cast<double>(start_t), static_cast<double>(step), k);
+
+        std::ranges::for_each(
+            std::views::iota(0, N),
+            [this, &table, t, precise, t_dd](int i) {
+                T phase = -t * table.log_n[i];
+                if constexpr (std::same_as<T, double>) {
+                    if (precise) phase = Zeta::reduceTwoPi(-(DoubleDouble(table.log_n[i], table.log_n_lo[i]) * t_dd));
+                }
+                std::complex<T> p = std::polar(table.inv_sqrt_n[i], phase);
+                phasor_re[i] = p.real();
+                phasor_im[i] = p.imag();
+            }
+        );
+    }
+
+    template <std::floating_point T>
+    typename EMSampler<T>::Value EMSampler<T>::next() {
+        if (k > 0 && k % resync_every == 0) resync();
+
+        const T t = start_t + static_cast<T>(k) * step;
+
+        // Partial sum over n < N, rotating every phasor to t + h in the same pass
+        T sum_re = T{0};
+        T sum_im = T{0};
+        const std::complex<T> N_pow_minus_s(phasor_re[N - 1], phasor_im[N - 1]);
+
+        {
+            ZETA_TIMED(DirichletSum);
+            ZETA_COUNT(TermsSummed, N - 1);
+            for (int i = 0; i < N - 1; ++i) {
+                const T p_re = phasor_re[i];
+                const T p_im = phasor_im[i];
+                sum_re += p_re;
+                sum_im += p_im;
+                phasor_re[i] = p_re * rotor_re[i] - p_im * rotor_im[i];
+                phasor_im[i] = p_re * rotor_im[i] + p_im * rotor_re[i];
+            }
+        }
+        phasor_re[N - 1] = N_pow_minus_s.real() * rotor_re[N - 1] - N_pow_minus_s.imag() * rotor_im[N - 1];
+        phasor_im[N - 1] = N_pow_minus_s.real() * rotor_im[N - 1] + N_pow_minus_s.imag() * rotor_re[N - 1];
+
+        const std::complex<T> s(T{0.5}, t);
+        const std::complex<T> zeta = std::complex<T>(sum_re, sum_im) + detail::tailEM(s, N, m, N_pow_minus_s);
+
+        T theta_val;
+        T theta_phase;
+        {
+            ZETA_TIMED(Theta);
+            theta_val = theta_value(t);
+            if constexpr (std::same_as<T, double>) {
+                const DoubleDouble t_exact = detail::gridPoint(start_t, step, k);
+                theta_phase = theta_reduced(t_exact.hi, t_exact.lo);
+            } else {
+                theta_phase = theta_reduced(t);
+            }
         }
+        const T z = (std::polar(T{1}, theta_phase) * zeta).real();
 
-    } 
+        ZETA_COUNT(Evaluations, 1);
+        ++k;
+        return { t, theta_val, zeta, z };
+    }
 
     // =====================================================================
     // Public API Implementation
     // =====================================================================
 
     template <std::floating_point T>
-    T compute(T t, Method method) {
-        if (std::abs(t) < T{1e-9}) return T{-0.5}; 
-
+    T compute(T t, Method method, const Options& options) {
         switch (method) {
             case Method::EulerMaclaurin:
-                return detail::computeEM<T>(t);
+                return compute<Method::EulerMaclaurin, T>(t, options);
             case Method::RiemannSiegel:
-                return detail::computeRS<T>(t);
+                return compute<Method::RiemannSiegel, T>(t, options);
+            case Method::RiemannSiegelRemainder:
+                return compute<Method::RiemannSiegelRemainder, T>(t, options);
             default:
                 return T{0};
         }
     }
 
-    template <std::floating_point T>
-    std::vector<T> computeBlock(T start_t, T length, int points, Method method) {
-        if (method == Method::OdlyzkoSchonhage) {
-            return detail::computeOS<T>(start_t, length, points);
+    template <Method M, std::floating_point T>
+    T compute(T t, const Options& options) {
+        static_assert(M != Method::OdlyzkoSchonhage, "Odlyzko-Schonhage evaluates grids: use computeBlock");
+
+        if (std::abs(t) < T{1e-9}) return detail::Z_AT_ZERO<T>;
+
+        ZETA_COUNT(Evaluations, 1);
+
+        if constexpr (M == Method::EulerMaclaurin) {
+            return detail::computeEM<T>(t, options.em_tolerance);
+        } else if constexpr (M == Method::RiemannSiegel) {
+            return detail::computeRS<T>(t);
+        } else {
+            return detail::computeRSR<T>(t, options.rs_order);
         }
+    }
 
-        T step = (points > 1) ? (length / static_cast<T>(points - 1)) : T{0};
-        auto indices = std::views::iota(0, points);
+    template <std::floating_point T>
+    std::vector<T> computeBlock(T start_t, T length, int points, Method method, const Options& options) {
+        if (points <= 0) return {};
+
+        std::vector<T> results(points);
+        const T step = (points > 1) ? (length / static_cast<T>(points - 1)) : T{0};
+        computeGrid<T>(start_t, step, 0, results, method, options);
+        return results;
+    }
+
+    template <std::floating_point T>
+    void computeGrid(T start_t, T step, std::int64_t first, std::span<T> out, Method method, const Options& options) {
+        if (out.empty()) return;
+
+        const std::int64_t last = first + static_cast<std::int64_t>(out.size());
+        const std::int64_t chunk = detail::blockChunk(method);
+        const std::int64_t first_chunk = first / chunk;
+        const int chunks = static_cast<int>((last + chunk - 1) / chunk - first_chunk);
+        const int threads = Parallel::availableThreads(options.pool, options.threads);
+
+        // Chunk c always covers [c * chunk, (c+1) * chunk) of the whole grid, so neither the thread
+        // count nor the split of a grid into calls changes the values
+        auto run_chunk = [&](int c, detail::BlockScratch<T>& scratch) {
+            const std::int64_t lo = std::max((first_chunk + c) * chunk, first);
+            const std::int64_t hi = std::min((first_chunk + c + 1) * chunk, last);
+            detail::computeRange<T>(start_t, step, lo, hi, method, options, out.subspan(lo - first, hi - lo), scratch);
+        };
+
+        if (threads <= 1 || chunks <= 1) {
+            detail::BlockScratch<T> scratch;
+            std::ranges::for_each(std::views::iota(0, chunks), [&](int c) { run_chunk(c, scratch); });
+            return;
+        }
 
-        return indices 
-            | std::views::transform([start_t, step, method](int i) {
-                T t = start_t + (static_cast<T>(i) * step);
-                return compute<T>(t, method);
-            })
-            | std::ranges::to<std::vector<T>>();
+        Parallel::WorkStealingPool& pool = Parallel::selectPool(options.pool, threads);
+        std::vector<detail::BlockScratch<T>> scratch(pool.size());
+        pool.parallelFor(chunks, [&](int c, int worker) { run_chunk(c, scratch[worker]); });
     }
 
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "Plotter.h"
 #include "HardyZ.h"
+#include "ZetaPlane.h"
+#include "ThreadPool.h"
+#include "Profile.h"
 #include <fstream>
 #include <iostream>
 #include <cmath>
@@ -9,10 +12,12 @@
 #include <functional>
 #include <ranges>
 #include <complex> 
+#include <numbers>
 
 PlotCanvas::PlotCanvas(int w, int h) : width(w), height(h) {
     pixels.resize(width * height * 3);
     std::fill(pixels.begin(), pixels.end(), 0); 
+    dirty = { 0, 0, width, height };
 }
 
 void PlotCanvas::set_pixel(int x, int y, const Color& c) {
@@ -21,6 +26,8 @@ void PlotCanvas::set_pixel(int x, int y, const Color& c) {
         pixels[idx] = c.r; 
         pixels[idx+1] = c.g; 
         pixels[idx+2] = c.b;
+        dirty.include(x, y);
+        ZETA_COUNT(PixelsDrawn, 1);
     }
 }
 
@@ -33,6 +40,7 @@ int PlotCanvas::to_screen_y(double val) const {
 }
 
 void PlotCanvas::draw_line_raw(int x0, int y0, int x1, int y1, const Color& c) {
+    ZETA_TIMED(Rasterize);
     int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
     int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
     int err = dx + dy, e2;
@@ -51,6 +59,7 @@ PlotCanvas& PlotCanvas::fill_background(const Color& c) {
         pixels[i+1] = c.g; 
         pixels[i+2] = c.b;
     }
+    dirty = { 0, 0, width, height };
     return *this;
 }
 
@@ -88,62 +97,95 @@ int map_y_val(double val, double min_val, double max_val, int screen_height) {
     return screen_height - 1 - static_cast<int>(t * (screen_height - 1));
 }
 
-void PlotCanvas::animate_function(const std::string& folder, 
-                                  std::function<double(double)> func, 
-                                  const double start_x, const double end_x, 
-                                  const int total_frames, 
+// Live rates for the progress line; empty unless built with ZETA_PROFILE. Evaluations only
+// show up when Z(t) is being computed alongside the animation (precomputed samples cost none).
+static std::string progress_rates(Zeta::Profile::Meter& evaluations, Zeta::Profile::Meter& frames) {
+    if constexpr (!Zeta::Profile::enabled) return {};
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(0) << " [" << frames.rate() << " frames/s";
+    const double eval_rate = evaluations.rate();
+    if (eval_rate > 0.0) line << ", " << eval_rate << " eval/s";
+    line << "]   ";
+    return line.str();
+}
+
+// Frame in which the segment ending at x is drawn when `frames` frames sweep [x_min, x_max] uniformly.
+// For uniform samples with one frame per segment this is the segment's index.
+static int segment_frame(double x, double x_min, double x_max, int frames) {
+    const double position = (x - x_min) / (x_max - x_min) * frames;
+    return std::clamp(static_cast<int>(std::ceil(position - 1e-9)) - 1, 0, frames - 1);
+}
+
+void PlotCanvas::animate_function(FrameSink& sink,
+                                  std::span<const double> xs,
+                                  std::span<const double> ys,
                                   const Color& startC, const Color& endC) {
-    
-    std::cout << "Animating in " << folder << "..." << std::endl;
-    
-    double view_min_x = start_x;
-    double view_max_x = end_x;
+    animate_function(sink, xs, ys, static_cast<int>(std::min(xs.size(), ys.size())) - 1, startC, endC);
+}
+
+void PlotCanvas::animate_function(FrameSink& sink,
+                                  std::span<const double> xs,
+                                  std::span<const double> ys,
+                                  int total_frames,
+                                  const Color& startC, const Color& endC) {
+    const int segments = static_cast<int>(std::min(xs.size(), ys.size())) - 1;
+    if (segments < 1 || total_frames < 1) return;
+
+    double view_min_x = xs.front();
+    double view_max_x = xs[segments];
     
     // We need to define a Y range that fits the Hardy Z function (usually +/- 5 or 10)
     double view_min_y = -6.0;
     double view_max_y =  6.0;
 
-    double step = (end_x - start_x) / total_frames;
-    double curr_x = start_x;
-    double curr_y = func(curr_x);
+    int prev_px = map_val(xs[0], view_min_x, view_max_x, width);
+    int prev_py = map_y_val(ys[0], view_min_y, view_max_y, height);
 
-    int prev_px = map_val(curr_x, view_min_x, view_max_x, width);
-    int prev_py = map_y_val(curr_y, view_min_y, view_max_y, height);
+    Zeta::Profile::Meter evaluations(Zeta::Profile::Counter::Evaluations);
+    Zeta::Profile::Meter frames(Zeta::Profile::Counter::FramesWritten);
 
+    int j = 0;
     for (int i = 0; i < total_frames; ++i) {
-        double next_x = curr_x + step;
-        double next_y = func(next_x);
-
-        int px = map_val(next_x, view_min_x, view_max_x, width);
-        int py = map_y_val(next_y, view_min_y, view_max_y, height);
-
         double t = (double)i / (total_frames - 1);
         Color c = Color::lerp(startC, endC, t);
 
-        draw_line_raw(prev_px, prev_py, px, py, c);
+        for (; j < segments && segment_frame(xs[j + 1], view_min_x, view_max_x, total_frames) <= i; ++j) {
+            int px = map_val(xs[j + 1], view_min_x, view_max_x, width);
+            int py = map_y_val(ys[j + 1], view_min_y, view_max_y, height);
 
-        curr_x = next_x;
-        prev_px = px;
-        prev_py = py;
+            draw_line_raw(prev_px, prev_py, px, py, c);
 
-        std::stringstream ss;
-        ss << folder << "/frame_" << std::setfill('0') << std::setw(4) << i << ".ppm";
-        save(ss.str());
+            prev_px = px;
+            prev_py = py;
+        }
+
+        write_frame(sink, i);
         
-        if (i % 50 == 0) std::cout << "Frame " << i << "\r" << std::flush;
+        if (show_progress && i % 50 == 0) std::cout << "Frame " << i << progress_rates(evaluations, frames) << "\r" << std::flush;
     }
-    std::cout << "\nDone." << std::endl;
+    if (show_progress) std::cout << "\nDone." << std::endl;
+}
+
+void PlotCanvas::animate_complex_zeta(FrameSink& sink,
+                                      std::span<const double> ts,
+                                      std::span<const double> zs,
+                                      std::span<const double> thetas,
+                                      const Color& startC,
+                                      const Color& endC) {
+    const int segments = static_cast<int>(std::min({ ts.size(), zs.size(), thetas.size() })) - 1;
+    animate_complex_zeta(sink, ts, zs, thetas, segments, startC, endC);
 }
 
-void PlotCanvas::animate_complex_zeta(const std::string& folder,
-                                      std::function<double(double)> hardy_func,
-                                      std::function<double(double)> theta_func,
-                                      double t_start, double t_end,
+void PlotCanvas::animate_complex_zeta(FrameSink& sink,
+                                      std::span<const double> ts,
+                                      std::span<const double> zs,
+                                      std::span<const double> thetas,
                                       int total_frames,
                                       const Color& startC,
                                       const Color& endC) {
-    
-    std::cout << "Animating Complex Zeta in " << folder << "..." << std::endl;
+    const int segments = static_cast<int>(std::min({ ts.size(), zs.size(), thetas.size() })) - 1;
+    if (segments < 1 || total_frames < 1) return;
 
     double view_min = -8.0;
     double view_max =  8.0;
@@ -161,51 +203,139 @@ void PlotCanvas::animate_complex_zeta(const std::string& folder,
     draw_line_raw(0, center_y, width, center_y, axis_col);
     draw_line_raw(center_x, 0, center_x, height, axis_col);
 
-    // Initial State
-    double step = (t_end - t_start) / total_frames;
-    
-    // RENAMED: Use 'current_t' to avoid confusion
-    double current_t = t_start; 
+    // zeta(1/2 + it) = Z(t) e^{-i theta(t)}
+    auto [prev_px, prev_py] = to_screen(std::polar(zs[0], -thetas[0]));
 
-    double z_val = hardy_func(current_t);
-    double th_val = theta_func(current_t);
-    
-    std::complex<double> current_zeta = std::polar(z_val, -th_val);
-    auto [prev_px, prev_py] = to_screen(current_zeta);
+    Zeta::Profile::Meter evaluations(Zeta::Profile::Counter::Evaluations);
+    Zeta::Profile::Meter frames(Zeta::Profile::Counter::FramesWritten);
 
+    int j = 0;
     for (int i = 0; i < total_frames; ++i) {
-        // FIX: Rename loop variable to 'progress' for Color Lerp
         double progress = (double)i / (total_frames - 1);
         Color c = Color::lerp(startC, endC, progress);
 
-        // FIX: Use current_t
-        double next_t = current_t + step;
-        
-        double next_z = hardy_func(next_t);
-        double next_th = theta_func(next_t);
-        std::complex<double> next_zeta = std::polar(next_z, -next_th);
+        for (; j < segments && segment_frame(ts[j + 1], ts.front(), ts[segments], total_frames) <= i; ++j) {
+            auto [px, py] = to_screen(std::polar(zs[j + 1], -thetas[j + 1]));
 
-        auto [px, py] = to_screen(next_zeta);
+            draw_line_raw(prev_px, prev_py, px, py, c);
 
-        draw_line_raw(prev_px, prev_py, px, py, c);
+            prev_px = px;
+            prev_py = py;
+        }
 
-        // Update State
-        current_t = next_t;
-        prev_px = px;
-        prev_py = py;
+        write_frame(sink, i);
+
+        if (show_progress && i % 50 == 0) {
+            std::cout << "Frame " << i << " (t=" << ts[j] << ")" << progress_rates(evaluations, frames) << "\r" << std::flush;
+        }
+    }
+    if (show_progress) std::cout << "\nComplex Animation Done." << std::endl;
+}
+
+PlotCanvas& PlotCanvas::draw_tiles(const std::function<void(const DirtyRect& block, std::span<Color> colors)>& shade,
+                                   int tile, int threads) {
+    ZETA_TIMED(Rasterize);
+    tile = std::max(tile, 1);
+    const int tiles_x = (width + tile - 1) / tile;
+    const int tiles_y = (height + tile - 1) / tile;
+    const int tiles = tiles_x * tiles_y;
+
+    auto run_tile = [&](int index) {
+        const DirtyRect block{ (index % tiles_x) * tile, (index / tiles_x) * tile,
+                               std::min((index % tiles_x + 1) * tile, width),
+                               std::min((index / tiles_x + 1) * tile, height) };
+        const int w = block.x1 - block.x0;
+        std::vector<Color> colors(w * (block.y1 - block.y0));
+        shade(block, colors);
+        for (int y = block.y0; y < block.y1; ++y) {
+            unsigned char* row = pixels.data() + (y * width + block.x0) * 3;
+            for (int x = 0; x < w; ++x) {
+                const Color& c = colors[(y - block.y0) * w + x];
+                row[3 * x] = c.r;
+                row[3 * x + 1] = c.g;
+                row[3 * x + 2] = c.b;
+            }
+        }
+    };
+
+    // sharedPool keeps every size it is asked for alive; ask for the budget, whatever the tile count
+    const int workers = Zeta::Parallel::resolveThreads(threads);
+    if (workers <= 1 || tiles <= 1) {
+        for (int i = 0; i < tiles; ++i) run_tile(i);
+    } else {
+        Zeta::Parallel::sharedPool(workers).parallelFor(tiles, [&](int index, int) { run_tile(index); });
+    }
+
+    ZETA_COUNT(PixelsDrawn, width * height);
+    dirty = { 0, 0, width, height };
+    return *this;
+}
+
+PlotCanvas& PlotCanvas::draw_image(std::span<const Color> image, int columns, int rows, int threads) {
+    if (columns <= 0 || rows <= 0 || image.size() < static_cast<size_t>(columns) * rows) return *this;
+    return draw_tiles([&](const DirtyRect& block, std::span<Color> colors) {
+        const int w = block.x1 - block.x0;
+        for (int y = block.y0; y < block.y1; ++y) {
+            const int row = static_cast<int>(static_cast<long long>(y) * rows / height);
+            for (int x = block.x0; x < block.x1; ++x) {
+                const int column = static_cast<int>(static_cast<long long>(x) * columns / width);
+                colors[(y - block.y0) * w + (x - block.x0)] = image[row * columns + column];
+            }
+        }
+    }, 64, threads);
+}
 
-        std::stringstream ss;
-        ss << folder << "/frame_" << std::setfill('0') << std::setw(4) << i << ".ppm";
-        save(ss.str());
+PlotCanvas& PlotCanvas::draw_zeta_plane(double sigma_min, double sigma_max, double t_min, double t_max,
+                                        double tolerance, int threads) {
+    const Zeta::Plane::Region<double> region{ sigma_min, sigma_max, t_min, t_max };
+    return draw_tiles([&](const DirtyRect& block, std::span<Color> colors) {
+        std::vector<std::complex<double>> values(colors.size());
+        Zeta::Plane::evaluateTile<double>(region, width, height, { block.x0, block.y0, block.x1, block.y1 },
+                                          values, tolerance);
+        std::ranges::transform(values, colors.begin(), &PlotCanvas::domain_color);
+    }, Zeta::Plane::TILE_SIZE, threads);
+}
 
-        if (i % 50 == 0) std::cout << "Frame " << i << " (t=" << current_t << ")\r" << std::flush;
+Color PlotCanvas::domain_color(std::complex<double> w) {
+    const double modulus = std::abs(w);
+    if (!std::isfinite(modulus)) return Color(255, 255, 255);
+    if (modulus == 0.0) return Color(0, 0, 0);
+
+    // HSL with full saturation: hue = arg w, lightness rising from 0 at zeros to 1 at poles,
+    // dimmed slightly just below each power of 2 so the level curves of |w| show as bands
+    const double hue = (std::arg(w) + std::numbers::pi) / (2.0 * std::numbers::pi) * 6.0;
+    const double band = std::log2(modulus) - std::floor(std::log2(modulus));
+    const double lightness = (2.0 / std::numbers::pi) * std::atan(std::sqrt(modulus)) * (0.85 + 0.15 * band);
+
+    const double chroma = 1.0 - std::abs(2.0 * lightness - 1.0);
+    const double second = chroma * (1.0 - std::abs(std::fmod(hue, 2.0) - 1.0));
+    const double base = lightness - chroma / 2.0;
+    double r = 0.0, g = 0.0, b = 0.0;
+    switch (std::min(static_cast<int>(hue), 5)) {
+        case 0: r = chroma; g = second; break;
+        case 1: r = second; g = chroma; break;
+        case 2: g = chroma; b = second; break;
+        case 3: g = second; b = chroma; break;
+        case 4: r = second; b = chroma; break;
+        default: r = chroma; b = second; break;
     }
-    std::cout << "\nComplex Animation Done." << std::endl;
+    auto channel = [base](double v) { return static_cast<uint8_t>(std::clamp((v + base) * 255.0, 0.0, 255.0)); };
+    return Color(channel(r), channel(g), channel(b));
 }
 
-void PlotCanvas::save(const std::string& filename) {
+bool PlotCanvas::save(const std::string& filename) {
     std::ofstream file(filename, std::ios::binary);
-    if (!file) { std::cerr << "Error opening " << filename << std::endl; return; }
+    if (!file) { std::cerr << "Error opening " << filename << std::endl; return false; }
     file << "P6\n" << width << " " << height << "\n255\n";
     file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
-}
\ No newline at end of file
+    file.close();
+    if (!file) { std::cerr << "Error writing " << filename << std::endl; return false; }
+    return true;
+}
+
+void PlotCanvas::write_frame(FrameSink& sink, int index) {
+    ZETA_TIMED(FrameWrite);
+    ZETA_COUNT(FramesWritten, 1);
+    sink.write_delta(pixels.data(), width, height, index, dirty);
+    dirty = {};
+}
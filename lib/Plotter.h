@@ -4,7 +4,11 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <iostream>
+#include <span>
 #include <cstdint>
+#include <complex>
+#include "FrameSink.h"
 
 struct Color {
     uint8_t r, g, b;
@@ -25,6 +29,8 @@ private:
     int width;
     int height;
     std::vector<unsigned char> pixels;
+    DirtyRect dirty; // pixels touched since the last write_frame
+    bool show_progress = true; // frame counter on stdout during animations
 
     void set_pixel(int x, int y, const Color& c);
     void draw_line_raw(int x0, int y0, int x1, int y1, const Color& c);
@@ -40,20 +46,134 @@ public:
     PlotCanvas& fill_background(const Color& c);
     PlotCanvas& draw_function(std::function<double(double)> func, const Color& c);
     PlotCanvas& draw_baseline(int y_pos, const Color& c);
+    // Turns the animations' "Frame i" progress line on stdout on or off (e.g. off when several run at once).
+    PlotCanvas& set_progress(bool enabled) { show_progress = enabled; return *this; }
     
-    void animate_function(const std::string& folder,std::function<double(double)> func, const double start_x, const double end_x, const int frame, const Color& startC, const Color& endC);
+    // Samples func (any double(double) callable, called directly rather than through std::function) at frame + 1 points.
+    template <typename F>
+    void animate_function(const std::string& folder, F&& func, const double start_x, const double end_x, const int frame, const Color& startC, const Color& endC);
+    template <typename F>
+    void animate_function(FrameSink& sink, F&& func, const double start_x, const double end_x, const int frame, const Color& startC, const Color& endC);
+    // Rasterizes precomputed samples: one frame per segment, so xs.size() - 1 frames.
+    void animate_function(FrameSink& sink, std::span<const double> xs, std::span<const double> ys, const Color& startC, const Color& endC);
+    // Non-uniform samples (e.g. Zeta::Hardy::sampleAdaptive) over `frames` frames advancing uniformly in x:
+    // frame i draws the segments ending in the i-th of `frames` equal parts of the range.
+    void animate_function(FrameSink& sink, std::span<const double> xs, std::span<const double> ys, int frames, const Color& startC, const Color& endC);
 
+    template <typename F, typename G>
     void animate_complex_zeta(const std::string& folder,
-                                std::function<double(double)> hardy_func,
-                                std::function<double(double)> theta_func,
+                                F&& hardy_func,
+                                G&& theta_func,
                                 double t_start, double t_end,
                                 int total_frames,
                                 const Color& startC,
                                 const Color& endC);
+    template <typename F, typename G>
+    void animate_complex_zeta(FrameSink& sink,
+                                F&& hardy_func,
+                                G&& theta_func,
+                                double t_start, double t_end,
+                                int total_frames,
+                                const Color& startC,
+                                const Color& endC);
+    // Samples of t, Z(t) and theta(t); draws zeta(1/2 + it) = Z(t) e^{-i theta(t)}, ts.size() - 1 frames.
+    void animate_complex_zeta(FrameSink& sink,
+                                std::span<const double> ts,
+                                std::span<const double> zs,
+                                std::span<const double> thetas,
+                                const Color& startC,
+                                const Color& endC);
+    // Non-uniform samples over `frames` frames advancing uniformly in t, as animate_function.
+    void animate_complex_zeta(FrameSink& sink,
+                                std::span<const double> ts,
+                                std::span<const double> zs,
+                                std::span<const double> thetas,
+                                int frames,
+                                const Color& startC,
+                                const Color& endC);
 
-    void save(const std::string& filename);
+    // Image plots. Shades the canvas in tile x tile blocks on `threads` workers (0: all cores);
+    // `shade` fills the block's colors row-major. Blocks are disjoint, so shade may run concurrently.
+    PlotCanvas& draw_tiles(const std::function<void(const DirtyRect& block, std::span<Color> colors)>& shade,
+                           int tile = 64, int threads = 0);
+    // Scales a columns x rows image (row-major, top row first) onto the canvas, nearest neighbour,
+    // on `threads` workers as draw_tiles.
+    PlotCanvas& draw_image(std::span<const Color> image, int columns, int rows, int threads = 0);
+    // Domain coloring of zeta(sigma + it), sigma left to right and t bottom to top, one value per pixel.
+    PlotCanvas& draw_zeta_plane(double sigma_min, double sigma_max, double t_min, double t_max,
+                                double tolerance = 1e-10, int threads = 0);
+    // Hue from arg(w), brightness from |w| with bands at powers of 2: zeros are black, poles white.
+    static Color domain_color(std::complex<double> w);
+
+    // Writes the canvas as a binary PPM; false if the file could not be written.
+    bool save(const std::string& filename);
+    // Passes the canvas and its dirty box to the sink, then clears the box.
+    void write_frame(FrameSink& sink, int index);
+    const DirtyRect& dirty_rect() const { return dirty; }
 
 };
 
+template <typename F>
+void PlotCanvas::animate_function(const std::string& folder, 
+                                  F&& func, 
+                                  const double start_x, const double end_x, 
+                                  const int total_frames, 
+                                  const Color& startC, const Color& endC) {
+    std::cout << "Animating in " << folder << "..." << std::endl;
+    PpmFileSink sink(folder);
+    animate_function(sink, func, start_x, end_x, total_frames, startC, endC);
+}
+
+template <typename F>
+void PlotCanvas::animate_function(FrameSink& sink, 
+                                  F&& func, 
+                                  const double start_x, const double end_x, 
+                                  const int total_frames, 
+                                  const Color& startC, const Color& endC) {
+    // Sample first, then rasterize: frame i draws the segment ending at xs[i + 1]
+    double step = (end_x - start_x) / total_frames;
+    std::vector<double> xs(total_frames + 1);
+    std::vector<double> ys(total_frames + 1);
+    for (int i = 0; i <= total_frames; ++i) {
+        xs[i] = start_x + i * step;
+        ys[i] = func(xs[i]);
+    }
+    animate_function(sink, std::span<const double>(xs), std::span<const double>(ys), startC, endC);
+}
+
+template <typename F, typename G>
+void PlotCanvas::animate_complex_zeta(const std::string& folder,
+                                      F&& hardy_func,
+                                      G&& theta_func,
+                                      double t_start, double t_end,
+                                      int total_frames,
+                                      const Color& startC,
+                                      const Color& endC) {
+    std::cout << "Animating Complex Zeta in " << folder << "..." << std::endl;
+    PpmFileSink sink(folder);
+    animate_complex_zeta(sink, hardy_func, theta_func, t_start, t_end, total_frames, startC, endC);
+}
+
+template <typename F, typename G>
+void PlotCanvas::animate_complex_zeta(FrameSink& sink,
+                                      F&& hardy_func,
+                                      G&& theta_func,
+                                      double t_start, double t_end,
+                                      int total_frames,
+                                      const Color& startC,
+                                      const Color& endC) {
+    double step = (t_end - t_start) / total_frames;
+    std::vector<double> ts(total_frames + 1);
+    std::vector<double> zs(total_frames + 1);
+    std::vector<double> thetas(total_frames + 1);
+    for (int i = 0; i <= total_frames; ++i) {
+        ts[i] = t_start + i * step;
+        zs[i] = hardy_func(ts[i]);
+        thetas[i] = theta_func(ts[i]);
+    }
+    animate_complex_zeta(sink, std::span<const double>(ts), std::span<const double>(zs), std::span<const double>(thetas),
+                         startC, endC);
+}
+
 
 #endif
\ No newline at end of file
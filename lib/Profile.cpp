@@ -0,0 +1,116 @@
+#include "Profile.h"
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Zeta::Profile {
+
+    namespace {
+
+        constexpr const char* COUNTER_NAMES[COUNTERS] = {
+            "evaluations", "terms_summed", "transcendental_calls", "pixels_drawn",
+            "frames_written", "bytes_written"
+        };
+
+        constexpr const char* STAGE_NAMES[STAGES] = {
+            "dirichlet_sum", "theta", "bernoulli_correction", "remainder", "nufft", "rasterize", "frame_write"
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<Shard>> shards;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        };
+
+        Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+    }
+
+    Shard& localShard() {
+        thread_local Shard* shard = [] {
+            Registry& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            reg.shards.push_back(std::make_unique<Shard>());
+            return reg.shards.back().get();
+        }();
+        return *shard;
+    }
+
+    Snapshot snapshot() {
+        Snapshot result;
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        for (const auto& shard : reg.shards) {
+            for (int i = 0; i < COUNTERS; ++i) result.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+            for (int i = 0; i < STAGES; ++i) {
+                result.stage_ns[i] += shard->stage_ns[i].load(std::memory_order_relaxed);
+                result.stage_calls[i] += shard->stage_calls[i].load(std::memory_order_relaxed);
+            }
+        }
+        result.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - reg.start).count();
+        return result;
+    }
+
+    void reset() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        for (const auto& shard : reg.shards) {
+            for (auto& c : shard->counters) c.store(0, std::memory_order_relaxed);
+            for (auto& c : shard->stage_ns) c.store(0, std::memory_order_relaxed);
+            for (auto& c : shard->stage_calls) c.store(0, std::memory_order_relaxed);
+        }
+        reg.start = std::chrono::steady_clock::now();
+    }
+
+    void writeReport(const std::string& path) {
+        if constexpr (!enabled) return;
+
+        const Snapshot snap = snapshot();
+        std::ofstream file(path);
+        if (!file) { std::cerr << "Error opening " << path << std::endl; return; }
+
+        const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+        if (csv) {
+            file << "kind,name,value,calls\n";
+            for (int i = 0; i < COUNTERS; ++i) file << "counter," << COUNTER_NAMES[i] << "," << snap.counters[i] << ",\n";
+            for (int i = 0; i < STAGES; ++i) {
+                file << "stage_ns," << STAGE_NAMES[i] << "," << snap.stage_ns[i] << "," << snap.stage_calls[i] << "\n";
+            }
+            file << "elapsed_s,total," << snap.elapsed_s << ",\n";
+            return;
+        }
+
+        file << "{\n  \"elapsed_s\": " << snap.elapsed_s << ",\n  \"counters\": {";
+        for (int i = 0; i < COUNTERS; ++i) {
+            file << (i ? ", " : "") << "\"" << COUNTER_NAMES[i] << "\": " << snap.counters[i];
+        }
+        file << "},\n  \"stages\": {";
+        for (int i = 0; i < STAGES; ++i) {
+            file << (i ? ",\n    " : "\n    ") << "\"" << STAGE_NAMES[i] << "\": {\"ns\": " << snap.stage_ns[i]
+                 << ", \"calls\": " << snap.stage_calls[i] << "}";
+        }
+        file << "\n  }\n}\n";
+    }
+
+    Meter::Meter(Counter counter) : counter(counter), last_time(std::chrono::steady_clock::now()) {
+        if constexpr (enabled) last_count = snapshot().counters[static_cast<int>(counter)];
+    }
+
+    double Meter::rate() {
+        if constexpr (!enabled) return 0.0;
+
+        const auto now = std::chrono::steady_clock::now();
+        const std::uint64_t count = snapshot().counters[static_cast<int>(counter)];
+        const double seconds = std::chrono::duration<double>(now - last_time).count();
+        const double result = seconds > 0.0 ? static_cast<double>(count - last_count) / seconds : 0.0;
+        last_count = count;
+        last_time = now;
+        return result;
+    }
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Zeta {
+
+    /**
+     * @namespace Profile
+     * @brief Per-stage counters and timers for the hot paths.
+     * * Compiled in only with `-DZETA_PROFILE` (`make PROFILE=1`); otherwise the ZETA_COUNT / ZETA_TIMED
+     *   macros expand to nothing and the report functions do nothing.
+     * * Each thread updates its own shard with relaxed atomics, so parallel blocks do not contend;
+     *   snapshot() sums the shards.
+     */
+    namespace Profile {
+
+#ifdef ZETA_PROFILE
+        inline constexpr bool enabled = true;
+#else
+        inline constexpr bool enabled = false;
+#endif
+
+        /**
+         * @brief Event counts.
+         */
+        enum class Counter : int {
+            Evaluations,          ///< Z(t) values produced (pointwise or in blocks)
+            TermsSummed,          ///< Terms of Dirichlet / main sums
+            TranscendentalCalls,  ///< pow, log, exp, sin/cos, polar (vector lanes counted individually)
+            PixelsDrawn,          ///< set_pixel calls inside the canvas
+            FramesWritten,
+            BytesWritten,         ///< Bytes handed to files, pipes and descriptors by the frame sinks
+            COUNT
+        };
+
+        /**
+         * @brief Timed stages. Nested stages are timed independently (a parent includes its children).
+         */
+        enum class Stage : int {
+            DirichletSum,         ///< Partial sums of n^{-s} / the Riemann-Siegel main sum
+            Theta,
+            BernoulliCorrection,  ///< Euler-Maclaurin tail
+            Remainder,            ///< Riemann-Siegel C_k series
+            NUFFT,
+            Rasterize,            ///< draw_line_raw
+            FrameWrite,           ///< PlotCanvas::write_frame, including the sink
+            COUNT
+        };
+
+        inline constexpr int COUNTERS = static_cast<int>(Counter::COUNT);
+        inline constexpr int STAGES = static_cast<int>(Stage::COUNT);
+
+        /**
+         * @brief Totals summed over all threads.
+         */
+        struct Snapshot {
+            std::array<std::uint64_t, COUNTERS> counters{};
+            std::array<std::uint64_t, STAGES> stage_ns{};
+            std::array<std::uint64_t, STAGES> stage_calls{};
+            double elapsed_s = 0.0; ///< Since the first event (or the last reset)
+        };
+
+        /**
+         * @brief One thread's counters; written only by its owner.
+         */
+        struct Shard {
+            std::array<std::atomic<std::uint64_t>, COUNTERS> counters{};
+            std::array<std::atomic<std::uint64_t>, STAGES> stage_ns{};
+            std::array<std::atomic<std::uint64_t>, STAGES> stage_calls{};
+        };
+
+        /**
+         * @brief The calling thread's shard, registered on first use and kept for the process lifetime.
+         */
+        [[nodiscard]]
+        Shard& localShard();
+
+        [[nodiscard]]
+        Snapshot snapshot();
+
+        /**
+         * @brief Zeroes every shard and restarts the clock.
+         */
+        void reset();
+
+        /**
+         * @brief Writes the totals as JSON, or as CSV when the path ends in ".csv". No-op when disabled.
+         */
+        void writeReport(const std::string& path);
+
+        /**
+         * @brief Rate of one counter between successive calls to rate(), e.g. live evaluations per second.
+         */
+        class Meter {
+        public:
+            explicit Meter(Counter counter);
+
+            /**
+             * @brief Events per second since construction or the previous call (0 when disabled).
+             */
+            double rate();
+
+        private:
+            Counter counter;
+            std::uint64_t last_count = 0;
+            std::chrono::steady_clock::time_point last_time;
+        };
+
+        inline void add(Counter counter, std::uint64_t n) noexcept {
+            if constexpr (enabled) {
+                auto& slot = localShard().counters[static_cast<int>(counter)];
+                slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Adds the lifetime of the object to a stage.
+         */
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(Stage stage) noexcept : stage(stage), start(std::chrono::steady_clock::now()) {}
+
+            ~ScopedTimer() {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                Shard& shard = localShard();
+                auto& total = shard.stage_ns[static_cast<int>(stage)];
+                auto& calls = shard.stage_calls[static_cast<int>(stage)];
+                total.store(total.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+                calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            Stage stage;
+            std::chrono::steady_clock::time_point start;
+        };
+
+    }
+}
+
+#define ZETA_PROFILE_JOIN_IMPL(a, b) a##b
+#define ZETA_PROFILE_JOIN(a, b) ZETA_PROFILE_JOIN_IMPL(a, b)
+
+#ifdef ZETA_PROFILE
+#define ZETA_COUNT(counter, n) ::Zeta::Profile::add(::Zeta::Profile::Counter::counter, static_cast<std::uint64_t>(n))
+#define ZETA_TIMED(stage) ::Zeta::Profile::ScopedTimer ZETA_PROFILE_JOIN(zeta_timer_, __LINE__)(::Zeta::Profile::Stage::stage)
+#else
+#define ZETA_COUNT(counter, n) ((void)0)
+#define ZETA_TIMED(stage) ((void)0)
+#endif
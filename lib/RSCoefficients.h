@@ -0,0 +1,37 @@
+#pragma once
+
+#include <concepts>
+
+namespace Zeta {
+
+    /**
+     * @brief Highest Riemann-Siegel remainder term $ C_k $ that is tabulated.
+     */
+    inline constexpr int RS_MAX_ORDER = 4;
+
+    /**
+     * @brief Evaluates the k-th Riemann-Siegel remainder coefficient $ C_k(p) $.
+     * The coefficients are derivatives of
+     * $$ \Psi(p) = \frac{\cos\left(2\pi(p^2 - p - \frac{1}{16})\right)}{\cos(2\pi p)} $$
+     * e.g. $ C_0 = \Psi $, $ C_1 = -\frac{\Psi^{(3)}}{96\pi^2} $, $ C_2 = \frac{\Psi^{(2)}}{64\pi^2} + \frac{\Psi^{(6)}}{18432\pi^4} $.
+     * Each $ C_k $ is stored as a Taylor polynomial in $ q = p - \frac{1}{2} $,
+     * generated by the compiler (detail::buildRSTable).
+     * @tparam T Floating point type (float, double, long double).
+     * @param k The index (0 <= k <= RS_MAX_ORDER).
+     * @param p The fractional part of $ \sqrt{t/2\pi} $, in $ [0, 1) $.
+     * @return The coefficient value.
+     */
+    template <std::floating_point T>
+    [[nodiscard]]
+    T riemannSiegelC(int k, T p);
+
+    /**
+     * @brief $ C_K(p) $ for a compile-time index: a fixed-length Horner loop over constant coefficients.
+     */
+    template <int K, std::floating_point T>
+    [[nodiscard]]
+    constexpr T riemannSiegelC(T p);
+
+}
+
+#include "RSCoefficients.tpp"
@@ -0,0 +1,206 @@
+#include <array>
+#include <numbers>
+#include <utility>
+#include <complex>
+
+namespace Zeta {
+
+    namespace detail {
+
+        /**
+         * @brief Number of Taylor coefficients of $ \Psi $ generated before truncation.
+         */
+        inline constexpr int RS_SERIES_DEGREE = 90;
+
+        /**
+         * @brief Number of samples on the contour used to extract the Taylor coefficients.
+         */
+        inline constexpr int RS_CONTOUR_SAMPLES = 256;
+
+        /**
+         * @brief Taylor polynomials of $ C_0, \dots, C_{K} $ in $ q = p - \frac{1}{2} $, each truncated to size[k] terms.
+         */
+        template <std::floating_point T>
+        struct RSTable {
+            std::array<std::array<T, RS_SERIES_DEGREE + 1>, RS_MAX_ORDER + 1> coefficients{};
+            std::array<int, RS_MAX_ORDER + 1> size{};
+        };
+
+        /**
+         * @brief $ e^x $ for the table builder: Taylor series of $ e^{|x|} $ (positive terms) after halving.
+         */
+        constexpr long double constexprExp(long double x) {
+            using LD = long double;
+            const bool negative = x < LD{0};
+            LD y = negative ? -x : x;
+            int halvings = 0;
+            while (y > LD{0.5}) { y /= LD{2}; ++halvings; }
+
+            LD sum = LD{1};
+            LD term = LD{1};
+            for (int n = 1; n < 40; ++n) {
+                term *= y / static_cast<LD>(n);
+                sum += term;
+            }
+            for (int i = 0; i < halvings; ++i) sum *= sum;
+            return negative ? LD{1} / sum : sum;
+        }
+
+        /**
+         * @brief $ (\cos x, \sin x) $ for the table builder: reduction to $ [-\pi, \pi] $, then Taylor series.
+         */
+        constexpr std::pair<long double, long double> constexprCosSin(long double x) {
+            using LD = long double;
+            constexpr LD TWO_PI = LD{2} * std::numbers::pi_v<LD>;
+            const LD turns = x / TWO_PI;
+            const long long whole = static_cast<long long>(turns + (turns >= LD{0} ? LD{0.5} : LD{-0.5}));
+            const LD r = x - static_cast<LD>(whole) * TWO_PI;
+
+            LD c = LD{1}, s = r;
+            LD term_c = LD{1}, term_s = r;
+            for (int n = 1; n < 24; ++n) {
+                term_c *= -r * r / static_cast<LD>((2 * n - 1) * (2 * n));
+                term_s *= -r * r / static_cast<LD>((2 * n) * (2 * n + 1));
+                c += term_c;
+                s += term_s;
+            }
+            return { c, s };
+        }
+
+        /**
+         * @brief $ \cos z = \cos x \cosh y - i \sin x \sinh y $ for the table builder.
+         */
+        constexpr std::complex<long double> constexprCos(std::complex<long double> z) {
+            const auto [c, s] = constexprCosSin(z.real());
+            const long double e = constexprExp(z.imag());
+            const long double inv_e = 1.0L / e;
+            return { c * (e + inv_e) / 2.0L, -s * (e - inv_e) / 2.0L };
+        }
+
+        /**
+         * @brief Builds the Taylor polynomials of $ C_0, \dots, C_4 $ in $ q = p - \frac{1}{2} $ at compile time.
+         * **Construction:**
+         * $ \Psi $ is entire (the zeros of $ \cos 2\pi p $ cancel), so its coefficients follow from Cauchy's formula
+         * $$ \psi_j = \frac{1}{2\pi r^j} \int_0^{2\pi} \Psi\left(\tfrac{1}{2} + r e^{i\phi}\right) e^{-ij\phi} \, d\phi $$
+         * evaluated by the trapezoidal rule on $ |q| = 1 $ in long double. Unlike power-series
+         * division, whose rounding errors grow like $ 4^j $ (the poles of $ 1/\cos 2\pi q $),
+         * this keeps every coefficient accurate to $ \varepsilon \max_{|q|=1} |\Psi| $.
+         * The derivatives $ \Psi^{(m)} $ are then combined with the standard weights
+         * (Edwards, *Riemann's Zeta Function*, 7.6).
+         * Trailing coefficients below $ 10^{-24} $ on $ |q| \leq \frac{1}{2} $ are dropped.
+         * The cosines come from constexprCos, as `std::cos` is not usable in constant expressions.
+         */
+        consteval RSTable<long double> buildRSTable() {
+            using LD = long double;
+            using CLD = std::complex<LD>;
+            constexpr LD PI = std::numbers::pi_v<LD>;
+            constexpr LD PI2 = PI * PI;
+            constexpr int D = RS_SERIES_DEGREE;
+            constexpr int K = RS_CONTOUR_SAMPLES;
+
+            // Roots of unity e^{2 pi i m / K}
+            std::array<CLD, K> roots{};
+            for (int m = 0; m < K; ++m) {
+                const auto [c, s] = constexprCosSin(LD{2} * PI * static_cast<LD>(m) / static_cast<LD>(K));
+                roots[m] = { c, s };
+            }
+
+            // Psi in terms of q: cos(2 pi q^2 - 5pi/8) / -cos(2 pi q)
+            std::array<CLD, K> samples{};
+            for (int m = 0; m < K; ++m) {
+                const CLD q = roots[m];
+                samples[m] = constexprCos(LD{2} * PI * q * q - LD{5} * PI / LD{8}) / -constexprCos(LD{2} * PI * q);
+            }
+
+            // Psi is real and even in q: only the real parts of even coefficients survive
+            std::array<LD, D + 1> psi{};
+            for (int j = 0; j <= D; j += 2) {
+                CLD acc{0, 0};
+                for (int m = 0; m < K; ++m) acc += samples[m] * std::conj(roots[j * m % K]);
+                psi[j] = acc.real() / static_cast<LD>(K);
+            }
+
+            // Taylor coefficients of Psi^{(m)}: psi_{j+m} (j+m)! / j!
+            auto derivative = [&psi](int m, int j) {
+                LD falling = LD{1};
+                for (int i = 1; i <= m; ++i) falling *= static_cast<LD>(j + i);
+                return psi[j + m] * falling;
+            };
+
+            struct Weight {
+                int m;
+                LD w;
+            };
+            const std::array<std::array<Weight, 4>, RS_MAX_ORDER + 1> weights = {{
+                {{ {0, LD{1}} }},
+                {{ {3, LD{-1} / (LD{96} * PI2)} }},
+                {{ {2, LD{1} / (LD{64} * PI2)}, {6, LD{1} / (LD{18432} * PI2 * PI2)} }},
+                {{ {1, LD{-1} / (LD{64} * PI2)}, {5, LD{-1} / (LD{3840} * PI2 * PI2)},
+                   {9, LD{-1} / (LD{5308416} * PI2 * PI2 * PI2)} }},
+                {{ {0, LD{1} / (LD{128} * PI2)}, {4, LD{19} / (LD{24576} * PI2 * PI2)},
+                   {8, LD{11} / (LD{5898240} * PI2 * PI2 * PI2)},
+                   {12, LD{1} / (LD{2038431744} * PI2 * PI2 * PI2 * PI2)} }}
+            }};
+
+            RSTable<LD> table;
+            for (int k = 0; k <= RS_MAX_ORDER; ++k) {
+                std::array<LD, D + 1>& poly = table.coefficients[k];
+                for (const Weight& weight : weights[k]) {
+                    if (weight.w == LD{0}) continue;
+                    for (int j = 0; j + weight.m <= D; ++j) poly[j] += weight.w * derivative(weight.m, j);
+                }
+
+                int last = D;
+                LD radius = LD{1};
+                for (int i = 0; i < D; ++i) radius *= LD{0.5};
+                while (last > 0 && (poly[last] < LD{0} ? -poly[last] : poly[last]) * radius < LD{1e-24}) {
+                    --last;
+                    radius *= LD{2};
+                }
+                table.size[k] = last + 1;
+            }
+            return table;
+        }
+
+        /**
+         * @brief The Riemann-Siegel coefficient table, evaluated by the compiler and rounded to T.
+         */
+        template <std::floating_point T>
+        inline constexpr RSTable<T> RS_TABLE = [] {
+            constexpr RSTable<long double> source = buildRSTable();
+            RSTable<T> converted;
+            for (int k = 0; k <= RS_MAX_ORDER; ++k) {
+                converted.size[k] = source.size[k];
+                for (int j = 0; j < source.size[k]; ++j) converted.coefficients[k][j] = static_cast<T>(source.coefficients[k][j]);
+            }
+            return converted;
+        }();
+
+    }
+
+    template <int K, std::floating_point T>
+    constexpr T riemannSiegelC(T p) {
+        static_assert(K >= 0 && K <= RS_MAX_ORDER, "C_K is tabulated for 0 <= K <= RS_MAX_ORDER");
+        constexpr const std::array<T, detail::RS_SERIES_DEGREE + 1>& poly = detail::RS_TABLE<T>.coefficients[K];
+        constexpr int size = detail::RS_TABLE<T>.size[K];
+        const T q = p - T{0.5};
+
+        // Horner's scheme over a fixed length
+        T acc = T{0};
+        for (int j = size - 1; j >= 0; --j) acc = acc * q + poly[j];
+        return acc;
+    }
+
+    template <std::floating_point T>
+    T riemannSiegelC(int k, T p) {
+        switch (k) {
+            case 0: return riemannSiegelC<0>(p);
+            case 1: return riemannSiegelC<1>(p);
+            case 2: return riemannSiegelC<2>(p);
+            case 3: return riemannSiegelC<3>(p);
+            case 4: return riemannSiegelC<4>(p);
+            default: return T{0};
+        }
+    }
+
+}
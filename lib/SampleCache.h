@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <compare>
+#include <concepts>
+#include "HardyZ.h"
+
+namespace Zeta::Hardy {
+
+    /**
+     * @brief Samples of the Hardy Z function on the grid $ t_k = t_0 + k \frac{t_1 - t_0}{count - 1} $.
+     * Together, $ Z $ and $ \theta $ give $ \zeta(\frac{1}{2} + it) = Z(t) e^{-i\theta(t)} $.
+     */
+    template <std::floating_point T>
+    struct Samples {
+        std::vector<T> t;
+        std::vector<T> z;
+        std::vector<T> theta;
+    };
+
+    /**
+     * @brief Memoizes Hardy::computeBlock passes keyed by (method, range, count, options),
+     * so several consumers of the same grid (e.g. plots of Z and of zeta) share one evaluation.
+     * Keys compare the range exactly. Options::threads is not part of the key (it does not change values).
+     * Safe for concurrent use: a grid is computed outside the lock, and concurrent requests for it wait on that one evaluation.
+     * @tparam T Floating point type (float, double, long double).
+     */
+    template <std::floating_point T>
+    class SampleCache {
+    public:
+        /**
+         * @brief Returns the samples for the grid, computing them on first request.
+         * @param start_t The first height $ t_0 $.
+         * @param end_t The last height $ t_1 $.
+         * @param count The number of samples (>= 1).
+         * @param method Algorithm passed to computeBlock.
+         * @param options Settings passed to computeBlock.
+         */
+        [[nodiscard]]
+        std::shared_ptr<const Samples<T>> get(T start_t, T end_t, int count,
+                                              Method method, const Options& options = {});
+
+        void clear();
+
+        [[nodiscard]]
+        std::size_t size() const;
+
+    private:
+        struct Key {
+            Method method;
+            T start_t;
+            T end_t;
+            int count;
+            int rs_order;
+            double em_tolerance;
+
+            auto operator<=>(const Key&) const = default;
+        };
+
+        mutable std::mutex mutex;
+        std::map<Key, std::shared_future<std::shared_ptr<const Samples<T>>>> entries;
+    };
+
+}
+
+#include "SampleCache.tpp"
@@ -0,0 +1,59 @@
+#include <ranges>
+#include <algorithm>
+
+namespace Zeta::Hardy {
+
+    template <std::floating_point T>
+    std::shared_ptr<const Samples<T>> SampleCache<T>::get(T start_t, T end_t, int count,
+                                                          Method method, const Options& options) {
+        const Key key{ method, start_t, end_t, count, options.rs_order, options.em_tolerance };
+
+        // The first request for a key publishes a future and computes outside the lock;
+        // concurrent requests for the same grid wait on that future instead of recomputing
+        std::promise<std::shared_ptr<const Samples<T>>> promise;
+        {
+            std::unique_lock lock(mutex);
+            if (auto it = entries.find(key); it != entries.end()) {
+                auto pending = it->second;
+                lock.unlock();
+                return pending.get();
+            }
+            entries.emplace(key, promise.get_future().share());
+        }
+
+        try {
+            auto samples = std::make_shared<Samples<T>>();
+            if (count > 0) {
+                const T step = (count > 1) ? (end_t - start_t) / static_cast<T>(count - 1) : T{0};
+
+                samples->t = std::views::iota(0, count)
+                    | std::views::transform([start_t, step](int k) { return start_t + static_cast<T>(k) * step; })
+                    | std::ranges::to<std::vector<T>>();
+                samples->z = computeBlock<T>(start_t, end_t - start_t, count, method, options);
+                samples->theta.resize(count);
+                Zeta::thetaGrid<T>(start_t, step, samples->theta);
+            }
+            promise.set_value(samples);
+            return samples;
+        } catch (...) {
+            // Waiters see the failure; later requests retry instead of inheriting it
+            promise.set_exception(std::current_exception());
+            std::lock_guard lock(mutex);
+            entries.erase(key);
+            throw;
+        }
+    }
+
+    template <std::floating_point T>
+    void SampleCache<T>::clear() {
+        std::lock_guard lock(mutex);
+        entries.clear();
+    }
+
+    template <std::floating_point T>
+    std::size_t SampleCache<T>::size() const {
+        std::lock_guard lock(mutex);
+        return entries.size();
+    }
+
+}
@@ -0,0 +1,340 @@
+#include "Shards.h"
+#include "Profile.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Zeta::Shards {
+
+    namespace {
+
+        void putU32(unsigned char* p, std::uint32_t v) {
+            for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+        }
+
+        void putU64(unsigned char* p, std::uint64_t v) {
+            for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+        }
+
+        void putF64(unsigned char* p, double v) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            putU64(p, bits);
+        }
+
+        std::uint32_t getU32(const unsigned char* p) {
+            std::uint32_t v = 0;
+            for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+            return v;
+        }
+
+        std::uint64_t getU64(const unsigned char* p) {
+            std::uint64_t v = 0;
+            for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+            return v;
+        }
+
+        double getF64(const unsigned char* p) {
+            const std::uint64_t bits = getU64(p);
+            double v;
+            std::memcpy(&v, &bits, sizeof(v));
+            return v;
+        }
+
+        std::uint64_t alignUp(std::uint64_t n) {
+            return (n + Format::COLUMN_ALIGN - 1) / Format::COLUMN_ALIGN * Format::COLUMN_ALIGN;
+        }
+
+        bool writeAll(int fd, const void* bytes, std::size_t size, std::uint64_t offset) {
+            const auto* p = static_cast<const unsigned char*>(bytes);
+            while (size > 0) {
+                const ssize_t n = ::pwrite(fd, p, size, static_cast<off_t>(offset));
+                if (n <= 0) return false;
+                p += n;
+                size -= static_cast<std::size_t>(n);
+                offset += static_cast<std::uint64_t>(n);
+            }
+            return true;
+        }
+
+    }
+
+    // =====================================================================
+    // Header
+    // =====================================================================
+
+    std::uint64_t Header::columnOffset(int column) const noexcept {
+        return Format::HEADER_SIZE + static_cast<std::uint64_t>(column) * alignUp(count * value_size);
+    }
+
+    std::uint64_t Header::fileSize() const noexcept {
+        return columnOffset(has_theta ? 3 : 2);
+    }
+
+    bool Header::sameGrid(const Header& other) const noexcept {
+        return method == other.method && value_size == other.value_size && has_theta == other.has_theta
+            && rs_order == other.rs_order && em_tolerance == other.em_tolerance
+            && start_t == other.start_t && start_t_lo == other.start_t_lo
+            && step == other.step && step_lo == other.step_lo && points == other.points;
+    }
+
+    namespace detail {
+
+        bool readHeader(const unsigned char* bytes, std::size_t size, Header& header) {
+            if (size < Format::HEADER_SIZE || std::memcmp(bytes, Format::MAGIC, 4) != 0
+                || getU32(bytes + 4) != Format::VERSION) {
+                return false;
+            }
+
+            const std::uint32_t method = getU32(bytes + 8);
+            if (method > static_cast<std::uint32_t>(Method::OdlyzkoSchonhage)) return false;
+
+            header.method = static_cast<Method>(method);
+            header.value_size = getU32(bytes + 12);
+            header.has_theta = (getU32(bytes + 16) & Format::FLAG_THETA) != 0;
+            header.rs_order = static_cast<std::int32_t>(getU32(bytes + 20));
+            header.em_tolerance = getF64(bytes + 24);
+            header.start_t = getF64(bytes + 32);
+            header.start_t_lo = getF64(bytes + 40);
+            header.step = getF64(bytes + 48);
+            header.step_lo = getF64(bytes + 56);
+            header.points = getU64(bytes + 64);
+            header.first = getU64(bytes + 72);
+            header.count = getU64(bytes + 80);
+            header.done = getU64(bytes + 88);
+            header.shard = getU32(bytes + 96);
+            header.shards = getU32(bytes + 100);
+
+            const bool known_size = header.value_size == 4 || header.value_size == 8 || header.value_size == 16;
+            return known_size && header.done <= header.count && header.first + header.count <= header.points;
+        }
+
+        void writeHeader(const Header& header, unsigned char* bytes) {
+            std::memset(bytes, 0, Format::HEADER_SIZE);
+            std::memcpy(bytes, Format::MAGIC, 4);
+            putU32(bytes + 4, Format::VERSION);
+            putU32(bytes + 8, static_cast<std::uint32_t>(header.method));
+            putU32(bytes + 12, header.value_size);
+            putU32(bytes + 16, header.has_theta ? Format::FLAG_THETA : 0);
+            putU32(bytes + 20, static_cast<std::uint32_t>(header.rs_order));
+            putF64(bytes + 24, header.em_tolerance);
+            putF64(bytes + 32, header.start_t);
+            putF64(bytes + 40, header.start_t_lo);
+            putF64(bytes + 48, header.step);
+            putF64(bytes + 56, header.step_lo);
+            putU64(bytes + 64, header.points);
+            putU64(bytes + 72, header.first);
+            putU64(bytes + 80, header.count);
+            putU64(bytes + 88, header.done);
+            putU32(bytes + 96, header.shard);
+            putU32(bytes + 100, header.shards);
+        }
+
+        // =================================================================
+        // ShardWriter
+        // =================================================================
+
+        ShardWriter::ShardWriter(const std::string& path, const Header& header) : info(header) {
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd < 0) { std::cerr << "Error opening " << path << std::endl; return; }
+
+            // One writer per shard, even when several nodes see the same directory
+            if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+                std::cerr << path << " is being written by another process" << std::endl;
+                ::close(fd);
+                fd = -1;
+                return;
+            }
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0) { ::close(fd); fd = -1; return; }
+
+            if (st.st_size == 0) {
+                // New shard: the header (done = 0) and the full column extent
+                info.done = 0;
+                unsigned char bytes[Format::HEADER_SIZE];
+                writeHeader(info, bytes);
+                if (!writeAll(fd, bytes, sizeof(bytes), 0) || ::ftruncate(fd, static_cast<off_t>(info.fileSize())) != 0
+                    || ::fsync(fd) != 0) {
+                    std::cerr << "Error creating " << path << std::endl;
+                    ::close(fd);
+                    fd = -1;
+                }
+                return;
+            }
+
+            // Existing shard: resume only if it was started by the same job
+            unsigned char bytes[Format::HEADER_SIZE];
+            Header existing;
+            const bool readable = ::pread(fd, bytes, sizeof(bytes), 0) == static_cast<ssize_t>(sizeof(bytes))
+                               && readHeader(bytes, sizeof(bytes), existing);
+            if (!readable || !existing.sameGrid(info) || existing.first != info.first || existing.count != info.count
+                || static_cast<std::uint64_t>(st.st_size) < existing.fileSize()) {
+                std::cerr << path << " exists and does not belong to this job" << std::endl;
+                ::close(fd);
+                fd = -1;
+                return;
+            }
+            info.done = existing.done;
+        }
+
+        ShardWriter::~ShardWriter() {
+            if (fd >= 0) ::close(fd);
+        }
+
+        bool ShardWriter::write(int column, std::uint64_t offset, const void* values, std::size_t bytes) {
+            if (fd < 0) return false;
+            ZETA_COUNT(BytesWritten, bytes);
+            return writeAll(fd, values, bytes, info.columnOffset(column) + offset * info.value_size);
+        }
+
+        bool ShardWriter::commit(std::uint64_t done) {
+            if (fd < 0) return false;
+
+            // Columns first, then the header that vouches for them
+            if (::fdatasync(fd) != 0) return false;
+            info.done = done;
+            unsigned char bytes[Format::HEADER_SIZE];
+            writeHeader(info, bytes);
+            return writeAll(fd, bytes, sizeof(bytes), 0) && ::fdatasync(fd) == 0;
+        }
+
+    }
+
+    // =====================================================================
+    // Sharding
+    // =====================================================================
+
+    Range shardRange(std::int64_t points, Method method, int shards, int shard) noexcept {
+        if (points <= 0 || shards <= 0 || shard < 0 || shard >= shards) return { 0, 0 };
+
+        const std::int64_t chunk = Hardy::detail::blockChunk(method);
+        const std::int64_t chunks = (points + chunk - 1) / chunk;
+        const auto boundary = [&](std::int64_t s) { return std::min(chunks * s / shards * chunk, points); };
+        return { boundary(shard), boundary(shard + 1) };
+    }
+
+    std::string shardPath(const std::string& directory, int shard) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "shard-%04d.zsc", shard);
+        return directory + "/" + name;
+    }
+
+    bool merge(std::span<const std::string> inputs, const std::string& output) {
+        if (inputs.empty()) { std::cerr << "Nothing to merge" << std::endl; return false; }
+
+        // The output is replaced before the inputs are copied, so it must not be one of them
+        for (const std::string& path : inputs) {
+            std::error_code ec;
+            if (!output.empty() && std::filesystem::equivalent(path, output, ec)) {
+                std::cerr << "Refusing to merge " << path << " into itself" << std::endl;
+                return false;
+            }
+        }
+
+        std::vector<std::unique_ptr<ScanFile>> files;
+        for (const std::string& path : inputs) {
+            files.push_back(std::make_unique<ScanFile>(path));
+            if (!files.back()->ok()) return false;
+        }
+
+        std::vector<int> order(files.size());
+        std::ranges::generate(order, [i = 0]() mutable { return i++; });
+        std::ranges::sort(order, {}, [&files](int i) { return std::pair{ files[i]->header().first, files[i]->header().count }; });
+
+        // Every shard complete and from one grid; together they cover [0, points) exactly.
+        // Empty shards (more shards than chunks) cover nothing and may start anywhere.
+        const Header& reference = files[order[0]]->header();
+        std::uint64_t covered = 0;
+        bool consistent = true;
+        for (int i : order) {
+            const Header& h = files[i]->header();
+            if (!h.sameGrid(reference)) {
+                std::cerr << inputs[i] << " belongs to a different grid than " << inputs[order[0]] << std::endl;
+                consistent = false;
+            } else if (h.done != h.count) {
+                std::cerr << inputs[i] << " is incomplete (" << h.done << " of " << h.count << " points)" << std::endl;
+                consistent = false;
+            } else if (h.count != 0 && h.first != covered) {
+                std::cerr << inputs[i] << " starts at point " << h.first << ", expected " << covered
+                          << (h.first > covered ? " (gap)" : " (overlap)") << std::endl;
+                consistent = false;
+            }
+            if (h.count != 0) covered = std::max(covered, h.first + h.count);
+        }
+        if (covered != reference.points) {
+            std::cerr << "Shards cover " << covered << " of " << reference.points << " points" << std::endl;
+            consistent = false;
+        }
+        if (!consistent || output.empty()) return consistent;
+
+        Header merged = reference;
+        merged.first = 0;
+        merged.count = reference.points;
+        merged.shard = 0;
+        merged.shards = 1;
+
+        std::remove(output.c_str());
+        detail::ShardWriter writer(output, merged);
+        if (!writer.ok()) return false;
+
+        const int columns = merged.has_theta ? 3 : 2;
+        for (int i : order) {
+            const Header& h = files[i]->header();
+            for (int c = 0; c < columns; ++c) {
+                const std::size_t bytes = h.count * h.value_size;
+                if (!writer.write(c, h.first, files[i]->bytes(c), bytes)) {
+                    std::cerr << "Error writing " << output << std::endl;
+                    return false;
+                }
+            }
+        }
+        return writer.commit(merged.count);
+    }
+
+    // =====================================================================
+    // ScanFile
+    // =====================================================================
+
+    ScanFile::ScanFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { std::cerr << "Error opening " << path << std::endl; return; }
+
+        struct stat st;
+        unsigned char bytes[Format::HEADER_SIZE];
+        const bool readable = ::fstat(fd, &st) == 0
+                           && ::pread(fd, bytes, sizeof(bytes), 0) == static_cast<ssize_t>(sizeof(bytes))
+                           && detail::readHeader(bytes, sizeof(bytes), info)
+                           && static_cast<std::uint64_t>(st.st_size) >= info.fileSize();
+        if (!readable) {
+            std::cerr << "Not a scan file: " << path << std::endl;
+            ::close(fd);
+            return;
+        }
+
+        void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) { std::cerr << "Error mapping " << path << std::endl; return; }
+
+        data = static_cast<const unsigned char*>(map);
+        size = static_cast<std::size_t>(st.st_size);
+    }
+
+    ScanFile::~ScanFile() {
+        if (data) ::munmap(const_cast<unsigned char*>(data), size);
+    }
+
+    const unsigned char* ScanFile::bytes(int column) const noexcept {
+        return data ? data + info.columnOffset(column) : nullptr;
+    }
+
+}
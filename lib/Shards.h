@@ -0,0 +1,257 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <concepts>
+#include <functional>
+#include "HardyZ.h"
+
+namespace Zeta {
+
+    /**
+     * @namespace Shards
+     * @brief Long Z(t) scans split into resumable shards with a columnar binary output.
+     * * A Job describes one grid $ t_k = t_0 + k h $, $ h = (t_1 - t_0) / (points - 1) $, like Hardy::computeBlock.
+     *   shardRange cuts it into chunk-aligned pieces, so the merged result matches one computeBlock call bit for bit.
+     * * Each shard is computed by runShard into its own file, by a local process or by a node sharing the
+     *   filesystem, and committed every few chunks; rerunning an interrupted shard continues from its last commit.
+     * * merge checks that a set of shard files covers one grid and concatenates them; ScanFile memory-maps a file
+     *   and exposes the columns as spans without copying.
+     */
+    namespace Shards {
+
+        /**
+         * @brief Scan file (.zsc) layout. Integers in the header are little-endian; the columns are
+         * arrays of the native floating type, each starting on a COLUMN_ALIGN boundary:
+         *
+         *     header  "ZSCN" | u32 version | u32 method | u32 value_size | u32 flags | i32 rs_order
+         *             | f64 em_tolerance | f64 start_t, lo | f64 step, lo | u64 points | u64 first | u64 count
+         *             | u64 done | u32 shard | u32 shards                     (HEADER_SIZE bytes, zero-padded)
+         *     columns t[count] | Z[count] | theta[count] if FLAG_THETA
+         *
+         * start_t and step are stored as double pairs (hi, lo) so long double grids round-trip.
+         * Entries [0, done) of every column are final; done == count marks a complete shard.
+         */
+        namespace Format {
+            inline constexpr char MAGIC[4] = { 'Z', 'S', 'C', 'N' };
+            inline constexpr std::uint32_t VERSION = 1;
+            inline constexpr std::size_t HEADER_SIZE = 128;
+            inline constexpr std::size_t COLUMN_ALIGN = 64;
+            inline constexpr std::uint32_t FLAG_THETA = 1;
+        }
+
+        /**
+         * @brief The decoded header of a scan file.
+         */
+        struct Header {
+            Method method = Method::RiemannSiegelRemainder;
+            std::uint32_t value_size = 0;   ///< sizeof of the floating type: 4, 8 or 16 (long double)
+            bool has_theta = false;
+            int rs_order = 0;
+            double em_tolerance = 0.0;
+            double start_t = 0.0, start_t_lo = 0.0;
+            double step = 0.0, step_lo = 0.0;
+            std::uint64_t points = 0;       ///< Points of the whole grid
+            std::uint64_t first = 0;        ///< Grid index of the file's first point
+            std::uint64_t count = 0;        ///< Points in this file
+            std::uint64_t done = 0;         ///< Points committed so far
+            std::uint32_t shard = 0;
+            std::uint32_t shards = 1;
+
+            /**
+             * @brief Byte offset of column `column` (0: t, 1: Z, 2: theta).
+             */
+            [[nodiscard]]
+            std::uint64_t columnOffset(int column) const noexcept;
+
+            /**
+             * @brief Total file size implied by the header.
+             */
+            [[nodiscard]]
+            std::uint64_t fileSize() const noexcept;
+
+            /**
+             * @brief True when both headers describe the same grid and evaluation settings.
+             */
+            [[nodiscard]]
+            bool sameGrid(const Header& other) const noexcept;
+        };
+
+        /**
+         * @brief A sharded scan of $ Z(t) $ over $ [t_0, t_1] $.
+         * @tparam T Floating point type (float, double, long double).
+         */
+        template <std::floating_point T>
+        struct Job {
+            T start_t;
+            T end_t;
+            std::int64_t points;
+            Method method = Method::RiemannSiegelRemainder;
+
+            /**
+             * @brief Passed to Hardy::computeGrid. Options::threads parallelizes within a shard.
+             */
+            Options options = {};
+
+            int shards = 1;
+
+            /**
+             * @brief Also store $ \theta(t_k) $, from which $ \zeta(\frac{1}{2} + it) = Z e^{-i\theta} $.
+             */
+            bool store_theta = false;
+
+            /**
+             * @brief computeBlock chunks (detail::blockChunk) between commits.
+             */
+            int checkpoint_chunks = 16;
+
+            [[nodiscard]]
+            T step() const noexcept {
+                return (points > 1) ? (end_t - start_t) / static_cast<T>(points - 1) : T{0};
+            }
+        };
+
+        /**
+         * @brief Grid indices [first, last).
+         */
+        struct Range {
+            std::int64_t first;
+            std::int64_t last;
+        };
+
+        /**
+         * @brief The part of a grid assigned to shard `shard` out of `shards`: whole computeBlock chunks,
+         * spread as evenly as possible. Shards beyond the number of chunks are empty.
+         */
+        [[nodiscard]]
+        Range shardRange(std::int64_t points, Method method, int shards, int shard) noexcept;
+
+        /**
+         * @brief File name of a shard inside `directory`: "shard-0007.zsc".
+         */
+        [[nodiscard]]
+        std::string shardPath(const std::string& directory, int shard);
+
+        /**
+         * @brief Progress callback of runShard: points committed and points in the shard.
+         */
+        using Progress = std::function<void(std::uint64_t done, std::uint64_t count)>;
+
+        /**
+         * @brief Computes (or resumes) one shard of a job into `path`.
+         * An existing file is resumed from its committed count if its header matches the job;
+         * otherwise runShard refuses to touch it.
+         * @return True when the shard is complete.
+         */
+        template <std::floating_point T>
+        bool runShard(const Job<T>& job, int shard, const std::string& path, const Progress& progress = {});
+
+        /**
+         * @brief Checks that `inputs` are complete shards covering one grid without gaps or overlaps
+         * and, unless `output` is empty, concatenates their columns into one scan file.
+         * Inputs may be given in any order. Problems are reported on std::cerr.
+         * @return True when the shards are consistent (and the output was written).
+         */
+        bool merge(std::span<const std::string> inputs, const std::string& output);
+
+        /**
+         * @brief A memory-mapped scan file; the columns point into the mapping (zero-copy).
+         */
+        class ScanFile {
+        public:
+            explicit ScanFile(const std::string& path);
+            ~ScanFile();
+
+            ScanFile(const ScanFile&) = delete;
+            ScanFile& operator=(const ScanFile&) = delete;
+
+            [[nodiscard]]
+            bool ok() const noexcept { return data != nullptr; }
+
+            [[nodiscard]]
+            const Header& header() const noexcept { return info; }
+
+            /**
+             * @brief The committed part of column `column` (0: t, 1: Z, 2: theta).
+             * Empty if sizeof(T) does not match the file or the column is absent.
+             */
+            template <std::floating_point T>
+            [[nodiscard]]
+            std::span<const T> column(int column) const noexcept;
+
+            /**
+             * @brief Start of column `column` in the mapping, whatever the floating type.
+             */
+            [[nodiscard]]
+            const unsigned char* bytes(int column) const noexcept;
+
+            template <std::floating_point T>
+            [[nodiscard]]
+            std::span<const T> t() const noexcept { return column<T>(0); }
+
+            template <std::floating_point T>
+            [[nodiscard]]
+            std::span<const T> z() const noexcept { return column<T>(1); }
+
+            template <std::floating_point T>
+            [[nodiscard]]
+            std::span<const T> theta() const noexcept { return column<T>(2); }
+
+        private:
+            const unsigned char* data = nullptr;
+            std::size_t size = 0;
+            Header info;
+        };
+
+        namespace detail {
+
+            [[nodiscard]]
+            bool readHeader(const unsigned char* bytes, std::size_t size, Header& header);
+
+            void writeHeader(const Header& header, unsigned char* bytes);
+
+            /**
+             * @brief Output side of runShard: creates or reopens a shard file and commits column ranges.
+             * Columns are written in place with pwrite; commit() syncs them before advancing `done`,
+             * so after a crash the header never claims data that is not on disk.
+             */
+            class ShardWriter {
+            public:
+                ShardWriter(const std::string& path, const Header& header);
+                ~ShardWriter();
+
+                ShardWriter(const ShardWriter&) = delete;
+                ShardWriter& operator=(const ShardWriter&) = delete;
+
+                [[nodiscard]]
+                bool ok() const noexcept { return fd >= 0; }
+
+                /**
+                 * @brief Points already committed (nonzero when resuming).
+                 */
+                [[nodiscard]]
+                std::uint64_t done() const noexcept { return info.done; }
+
+                /**
+                 * @brief Writes entries [offset, offset + bytes / value_size) of a column.
+                 */
+                bool write(int column, std::uint64_t offset, const void* values, std::size_t bytes);
+
+                /**
+                 * @brief Makes the written entries durable and records `done` in the header.
+                 */
+                bool commit(std::uint64_t done);
+
+            private:
+                int fd = -1;
+                Header info;
+            };
+
+        }
+
+    }
+}
+
+#include "Shards.tpp"
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <ranges>
+
+namespace Zeta::Shards {
+
+    template <std::floating_point T>
+    bool runShard(const Job<T>& job, int shard, const std::string& path, const Progress& progress) {
+        if (job.points <= 0 || shard < 0 || shard >= job.shards) return false;
+
+        const Range range = shardRange(job.points, job.method, job.shards, shard);
+        const T step = job.step();
+
+        Header header;
+        header.method = job.method;
+        header.value_size = sizeof(T);
+        header.has_theta = job.store_theta;
+        header.rs_order = job.options.rs_order;
+        header.em_tolerance = job.options.em_tolerance;
+        header.start_t = static_cast<double>(job.start_t);
+        header.start_t_lo = static_cast<double>(job.start_t - static_cast<T>(header.start_t));
+        header.step = static_cast<double>(step);
+        header.step_lo = static_cast<double>(step - static_cast<T>(header.step));
+        header.points = static_cast<std::uint64_t>(job.points);
+        header.first = static_cast<std::uint64_t>(range.first);
+        header.count = static_cast<std::uint64_t>(range.last - range.first);
+        header.shard = static_cast<std::uint32_t>(shard);
+        header.shards = static_cast<std::uint32_t>(job.shards);
+
+        detail::ShardWriter writer(path, header);
+        if (!writer.ok()) return false;
+
+        const std::int64_t count = range.last - range.first;
+        const int chunk = Hardy::detail::blockChunk(job.method);
+        const int batch = std::max(job.checkpoint_chunks, 1) * chunk;
+
+        std::vector<T> t_col, z_col, theta_col;
+
+        // Commits stay chunk-aligned (range.first and batch are multiples of blockChunk), so a resumed
+        // shard evaluates exactly the chunks an uninterrupted one would
+        for (std::int64_t done = static_cast<std::int64_t>(writer.done()); done < count; ) {
+            const std::int64_t first = range.first + done;
+            const int n = static_cast<int>(std::min<std::int64_t>(batch, count - done));
+
+            t_col.resize(n);
+            z_col.resize(n);
+            std::ranges::for_each(
+                std::views::iota(0, n),
+                [&t_col, &job, step, first](int j) { t_col[j] = job.start_t + static_cast<T>(first + j) * step; }
+            );
+            Hardy::computeGrid<T>(job.start_t, step, first, z_col, job.method, job.options);
+
+            bool written = writer.write(0, done, t_col.data(), n * sizeof(T))
+                        && writer.write(1, done, z_col.data(), n * sizeof(T));
+            if (job.store_theta) {
+                // A fresh expansion per chunk: its anchors, and so the bytes, depend on the grid index only,
+                // not on where this shard starts or resumed
+                theta_col.resize(n);
+                for (int lo = 0; lo < n; lo += chunk) {
+                    ThetaExpansion<T> thetas;
+                    const int hi = std::min(lo + chunk, n);
+                    std::transform(t_col.begin() + lo, t_col.begin() + hi, theta_col.begin() + lo,
+                                   [&thetas](T t) { return thetas(t); });
+                }
+                written = written && writer.write(2, done, theta_col.data(), n * sizeof(T));
+            }
+            if (!written || !writer.commit(done + n)) return false;
+
+            done += n;
+            if (progress) progress(static_cast<std::uint64_t>(done), static_cast<std::uint64_t>(count));
+        }
+        return true;
+    }
+
+    template <std::floating_point T>
+    std::span<const T> ScanFile::column(int column) const noexcept {
+        if (!data || info.value_size != sizeof(T) || column < 0 || column > 2) return {};
+        if (column == 2 && !info.has_theta) return {};
+        return { reinterpret_cast<const T*>(bytes(column)), static_cast<std::size_t>(info.done) };
+    }
+
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <concepts>
+#include <array>
+#include <algorithm>
+#include <span>
+#include "DoubleDouble.h"
 
 namespace Zeta {
 
@@ -17,6 +21,135 @@ namespace Zeta {
     [[nodiscard]] 
     constexpr T theta(T t) noexcept;
 
+    /**
+     * @brief $ \theta(t) $ in double-double precision, for phases at large heights.
+     * At $ t \approx 10^{10} $, $ \theta(t) \approx 10^{11} $ and a double keeps only ~5 digits after
+     * the point; this overload keeps the leading terms to ~32 digits, so that after reduction
+     * modulo $ 2\pi $ (Zeta::reduceTwoPi) the phase is still accurate to ~1e-16.
+     * The $ 1/t $ corrections are small enough to be summed in double.
+     */
+    [[nodiscard]]
+    DoubleDouble theta(DoubleDouble t) noexcept;
+
+    /**
+     * @brief Evaluates $ \theta $ near a moving anchor $ t_a $ from its Taylor expansion
+     * $$ \theta(t_a + \delta) \approx \sum_{i=0}^{4} \frac{\theta^{(i)}(t_a)}{i!} \delta^i $$
+     * Only the anchor pays for a logarithm; every other point is a degree-4 Horner step.
+     * Since $ |\theta^{(5)}| \approx 3/t^4 $, the block half-width $ R $ is chosen so the truncation stays
+     * within a few ulps of $ \theta(t_a) $ (about 15 at $ t = 10^4 $). A point outside the block moves
+     * the anchor ahead of it in the direction of travel, so monotone sweeps re-anchor once per $ \sim R $.
+     * With `modulo_two_pi` the values are $ \theta $ reduced to $ [-\pi, \pi] $ (plus the polynomial),
+     * the anchor is taken in double-double for double, and $ R $ is also capped so the polynomial
+     * keeps the absolute error near 1e-14 at any height. This is the form the main sums need.
+     * @tparam T Floating point type (float, double, long double).
+     */
+    template <std::floating_point T>
+    class ThetaExpansion {
+    public:
+        explicit ThetaExpansion(bool modulo_two_pi = false) noexcept : modulo(modulo_two_pi) {}
+
+        /**
+         * @brief $ \theta(t + t_\text{lo}) $, re-anchoring if needed.
+         * @param t_lo Optional low part of the argument (e.g. of an unrounded grid point).
+         */
+        [[nodiscard]]
+        T operator()(T t, T t_lo = T{0});
+
+        /**
+         * @brief $ \theta'(t) $ from the same expansion.
+         */
+        [[nodiscard]]
+        T slope(T t);
+
+        /**
+         * @brief Moves the anchor to $ t $ and returns the half-width $ R $ of its block.
+         */
+        T anchor(T t);
+
+        /**
+         * @brief Whether $ t $ lies in the current block.
+         */
+        [[nodiscard]]
+        bool covers(T t) const noexcept { return radius > T{0} && t >= t_a - radius && t <= t_a + radius; }
+
+        /**
+         * @brief The expansion at offset $ \delta $ from the anchor (no range check).
+         */
+        [[nodiscard]]
+        T at(T delta) const noexcept {
+            return c[0] + delta * (c[1] + delta * (c[2] + delta * (c[3] + delta * c[4])));
+        }
+
+        [[nodiscard]]
+        T anchorPoint() const noexcept { return t_a; }
+
+        /**
+         * @brief Half-width $ R $ of the current block (0 before the first anchor or below $ t = 1 $).
+         */
+        [[nodiscard]]
+        T halfWidth() const noexcept { return std::max(radius, T{0}); }
+
+        /**
+         * @brief Number of anchors so far, i.e. direct evaluations of $ \theta $.
+         */
+        [[nodiscard]]
+        long long anchors() const noexcept { return anchor_count; }
+
+    private:
+        void follow(T t);
+
+        bool modulo;
+        T t_a = T{0};
+        T radius = T{-1};
+        T last_t = T{0};
+        std::array<T, 5> c{};
+        long long anchor_count = 0;
+    };
+
+    /**
+     * @brief $ \theta $ for every element of a span (`out` must be at least as long as `t`).
+     * Runs through one ThetaExpansion, so sorted or clustered inputs pay for one logarithm per block.
+     */
+    template <std::floating_point T>
+    void theta(std::span<const T> t, std::span<T> out);
+
+    /**
+     * @brief $ \theta(t_k) $ for $ t_k = t_0 + k h $, $ k = 0, \ldots, $ out.size() - 1.
+     * The points are formed as `start_t + k * step`, like the callers' grids. Per block one anchor,
+     * then a branch-free polynomial loop the compiler can vectorize.
+     * @param modulo_two_pi As for ThetaExpansion.
+     */
+    template <std::floating_point T>
+    void thetaGrid(T start_t, T step, std::span<T> out, bool modulo_two_pi = false);
+
+    /**
+     * @brief Inverse of $ \theta $ on its increasing branch $ t > 2\pi $: the $ t $ with $ \theta(t) = \vartheta $.
+     * Starts from $ t \approx 2\pi \exp\left(1 + W\left(\frac{\vartheta + \pi/8}{\pi e}\right)\right) $
+     * (the leading terms of $ \theta $ inverted through Lambert W) and polishes with Newton on the exact $ \theta' $.
+     * @param value The target $ \vartheta \geq -\pi $.
+     */
+    template <std::floating_point T>
+    [[nodiscard]]
+    T thetaInverse(T value);
+
+    /**
+     * @brief Mean spacing of the zeros of $ Z $ at height t, $ 2\pi / \ln(t/2\pi) $ (the inverse density
+     * $ \theta'(t) / \pi $), clamped to $ 2\pi $ below $ t = 2\pi e $.
+     */
+    template <std::floating_point T>
+    [[nodiscard]]
+    T meanGap(T t);
+
+    namespace detail {
+
+        /**
+         * @brief Principal branch of the Lambert W function for $ x \geq -1/e $ (Halley iteration).
+         */
+        [[nodiscard]]
+        double lambertW(double x);
+
+    }
+
 } 
 
 #include "Theta.tpp"
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <cmath>
 #include <numbers> 
+#include <limits>
+#include <algorithm>
 
 namespace Zeta {
 
@@ -22,4 +24,170 @@ namespace Zeta {
         return term_log + term_linear + term_const + term_corr1 + term_corr2;
     }
 
-} 
\ No newline at end of file
+    inline DoubleDouble theta(DoubleDouble t) noexcept {
+        const double t_dbl = static_cast<double>(t);
+        if (std::abs(t_dbl) < 1e-9) return {};
+
+        const DoubleDouble half_t(t.hi * 0.5, t.lo * 0.5);
+        const DoubleDouble term_log = half_t * Zeta::log(t / DD::TWO_PI);
+        const DoubleDouble term_const(-DD::PI.hi / 8.0, -DD::PI.lo / 8.0);
+
+        const double t3 = t_dbl * t_dbl * t_dbl;
+        const double term_corr = 1.0 / (48.0 * t_dbl) + 7.0 / (5760.0 * t3);
+
+        return term_log - half_t + term_const + DoubleDouble(term_corr);
+    }
+
+    // =====================================================================
+    // ThetaExpansion
+    // =====================================================================
+
+    template <std::floating_point T>
+    T ThetaExpansion<T>::anchor(T t) {
+        constexpr T TWO_PI = T{2} * std::numbers::pi_v<T>;
+        constexpr T EPS = std::numeric_limits<T>::epsilon();
+
+        t_a = t;
+        ++anchor_count;
+
+        T value;
+        if (!modulo) {
+            value = Zeta::theta<T>(t);
+        } else if constexpr (std::same_as<T, double>) {
+            value = Zeta::reduceTwoPi(Zeta::theta(DoubleDouble(t)));
+        } else {
+            value = std::remainder(Zeta::theta<T>(t), TWO_PI);
+        }
+
+        // Below t = 1 the series is not worth it; every point becomes its own anchor
+        if (!(t > T{1})) {
+            c = { value, T{0}, T{0}, T{0}, T{0} };
+            radius = T{0};
+            return radius;
+        }
+
+        // theta^(i)(t) / i!, from theta = (t/2) ln(t/2pi) - t/2 - pi/8 + 1/(48t) + 7/(5760t^3)
+        const T inv = T{1} / t;
+        const T inv2 = inv * inv;
+        const T inv3 = inv2 * inv;
+        c[0] = value;
+        c[1] = T{0.5} * std::log(t / TWO_PI) - inv2 / T{48} - T{7} * inv2 * inv2 / T{1920};
+        c[2] = (inv / T{2} + inv3 / T{24} + T{7} * inv3 * inv2 / T{480}) / T{2};
+        c[3] = -(inv2 / T{2} + inv2 * inv2 / T{8} + T{7} * inv3 * inv3 / T{96}) / T{6};
+        c[4] = (inv3 + inv3 * inv2 / T{2} + T{7} * inv3 * inv3 * inv / T{16}) / T{24};
+
+        // Truncation |theta^(5)| |delta|^5 / 5! <= 0.4 |delta|^5 / t^4 on [t/2, 3t/2]; solve for |delta| <= R
+        const T tol = modulo ? T{8} * EPS * TWO_PI : T{4} * EPS * std::abs(value);
+        T r = t * std::pow(T{2.5} * tol / t, T{0.2});
+        if (modulo) r = std::min(r, tol / (T{4} * EPS * std::abs(c[1]))); // rounding of c_1 delta
+        radius = std::min(r, t / T{2});
+        return radius;
+    }
+
+    template <std::floating_point T>
+    void ThetaExpansion<T>::follow(T t) {
+        if (!covers(t)) {
+            // Anchor ahead of t in the direction of travel, so the next points fall in the same block
+            const T ahead = (radius > T{0}) ? T{0.75} * radius : T{0};
+            anchor((t >= last_t) ? t + ahead : t - ahead);
+            if (!covers(t)) anchor(t);
+        }
+        last_t = t;
+    }
+
+    template <std::floating_point T>
+    T ThetaExpansion<T>::operator()(T t, T t_lo) {
+        follow(t);
+        return at((t - t_a) + t_lo); // t - t_a is exact: both lie within a factor 2
+    }
+
+    template <std::floating_point T>
+    T ThetaExpansion<T>::slope(T t) {
+        follow(t);
+        const T delta = t - t_a;
+        return c[1] + delta * (T{2} * c[2] + delta * (T{3} * c[3] + delta * T{4} * c[4]));
+    }
+
+    // =====================================================================
+    // Batched evaluation and inverse
+    // =====================================================================
+
+    template <std::floating_point T>
+    void theta(std::span<const T> t, std::span<T> out) {
+        ThetaExpansion<T> expansion;
+        for (std::size_t i = 0; i < t.size(); ++i) out[i] = expansion(t[i]);
+    }
+
+    template <std::floating_point T>
+    void thetaGrid(T start_t, T step, std::span<T> out, bool modulo_two_pi) {
+        ThetaExpansion<T> expansion(modulo_two_pi);
+        const int count = static_cast<int>(out.size());
+
+        int k = 0;
+        while (k < count) {
+            out[k] = expansion(start_t + static_cast<T>(k) * step);
+            const T t_a = expansion.anchorPoint();
+
+            // Last grid index inside the block [t_a - R, t_a + R]
+            int end = count;
+            if (step != T{0}) {
+                const T edge = (step > T{0}) ? t_a + expansion.halfWidth() : t_a - expansion.halfWidth();
+                const T limit = std::floor((edge - start_t) / step) + T{1};
+                end = static_cast<int>(std::clamp(limit, static_cast<T>(k + 1), static_cast<T>(count)));
+            }
+
+            for (int j = k + 1; j < end; ++j) {
+                out[j] = expansion.at((start_t + static_cast<T>(j) * step) - t_a);
+            }
+            k = end;
+        }
+    }
+
+    template <std::floating_point T>
+    T meanGap(T t) {
+        constexpr T TWO_PI = T{2} * std::numbers::pi_v<T>;
+        return TWO_PI / std::max(std::log(std::abs(t) / TWO_PI), T{1});
+    }
+
+    template <std::floating_point T>
+    T thetaInverse(T value) {
+        constexpr T TWO_PI = T{2} * std::numbers::pi_v<T>;
+
+        // theta(t) ~ (t/2) ln(t / 2 pi e) - pi/8 = pi e^{1+w} w - pi/8 for t = 2 pi e^{1+w}
+        const double x = (static_cast<double>(value) + std::numbers::pi / 8.0) / (std::numbers::pi * std::numbers::e);
+        T t = static_cast<T>(2.0 * std::numbers::pi * std::exp(1.0 + detail::lambertW(x)));
+
+        for (int iter = 0; iter < 8; ++iter) {
+            const T inv2 = T{1} / (t * t);
+            const T slope = T{0.5} * std::log(t / TWO_PI) - inv2 / T{48} - T{7} * inv2 * inv2 / T{1920};
+            const T delta = (Zeta::theta<T>(t) - value) / slope;
+            t -= delta;
+            if (std::abs(delta) <= T{4} * std::numeric_limits<T>::epsilon() * t) break;
+        }
+
+        return t;
+    }
+
+    namespace detail {
+
+        inline double lambertW(double x) {
+            constexpr double INV_E = 1.0 / std::numbers::e;
+            if (x <= -INV_E) return -1.0;
+
+            // Branch-point series near -1/e, otherwise log asymptotics
+            double w = (x < 1.0) ? std::sqrt(2.0 * (std::numbers::e * x + 1.0)) - 1.0
+                                 : std::log(x) - std::log(std::max(std::log(x), 1.0));
+
+            for (int iter = 0; iter < 32; ++iter) {
+                const double e_w = std::exp(w);
+                const double f = w * e_w - x;
+                const double delta = f / (e_w * (w + 1.0) - (w + 2.0) * f / (2.0 * w + 2.0));
+                w -= delta;
+                if (std::abs(delta) <= 1e-15 * (1.0 + std::abs(w))) break;
+            }
+            return w;
+        }
+
+    }
+
+}
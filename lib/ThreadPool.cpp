@@ -0,0 +1,128 @@
+#include "ThreadPool.h"
+#include <map>
+#include <algorithm>
+
+namespace Zeta::Parallel {
+
+    int resolveThreads(int threads) noexcept {
+        if (threads > 0) return threads;
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 0 ? static_cast<int>(hw) : 1;
+    }
+
+    WorkStealingPool::WorkStealingPool(int threads) {
+        const int count = resolveThreads(threads);
+        queues.reserve(count);
+        for (int i = 0; i < count; ++i) queues.push_back(std::make_unique<Queue>());
+
+        workers.reserve(count);
+        for (int i = 0; i < count; ++i) workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::lock_guard lock(state_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& w : workers) w.join();
+    }
+
+    void WorkStealingPool::parallelFor(int chunks, const std::function<void(int, int)>& body) {
+        if (chunks <= 0) return;
+
+        std::lock_guard submit(submit_mutex);
+
+        // Deal contiguous runs so neighbouring chunks (similar cost, shared cache state) stay together
+        const int n = size();
+        for (int w = 0; w < n; ++w) {
+            const int begin = static_cast<int>(static_cast<long long>(chunks) * w / n);
+            const int end = static_cast<int>(static_cast<long long>(chunks) * (w + 1) / n);
+            std::lock_guard lock(queues[w]->mutex);
+            for (int c = begin; c < end; ++c) queues[w]->chunks.push_back(c);
+        }
+
+        {
+            std::lock_guard lock(state_mutex);
+            job = &body;
+            remaining.store(chunks, std::memory_order_release);
+            ++generation;
+        }
+        wake.notify_all();
+
+        // Waiting for idle workers too guarantees nobody still holds `body` when the next job is dealt
+        std::unique_lock lock(state_mutex);
+        done.wait(lock, [this] { return remaining.load(std::memory_order_acquire) == 0 && active == 0; });
+        job = nullptr;
+    }
+
+    bool WorkStealingPool::popOrSteal(int id, int& chunk) {
+        {
+            Queue& own = *queues[id];
+            std::lock_guard lock(own.mutex);
+            if (!own.chunks.empty()) {
+                chunk = own.chunks.back();
+                own.chunks.pop_back();
+                return true;
+            }
+        }
+
+        const int n = size();
+        for (int offset = 1; offset < n; ++offset) {
+            Queue& victim = *queues[(id + offset) % n];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.chunks.empty()) {
+                chunk = victim.chunks.front();
+                victim.chunks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::workerLoop(int id) {
+        unsigned seen = 0;
+        while (true) {
+            const std::function<void(int, int)>* current = nullptr;
+            {
+                std::unique_lock lock(state_mutex);
+                wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = job;
+                if (!current) continue; // woke after that job already completed
+                ++active;
+            }
+
+            int chunk = 0;
+            while (popOrSteal(id, chunk)) {
+                (*current)(chunk, id);
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            std::lock_guard lock(state_mutex);
+            --active;
+            if (active == 0) done.notify_all();
+        }
+    }
+
+    WorkStealingPool& sharedPool(int threads) {
+        static std::mutex mutex;
+        static std::map<int, std::unique_ptr<WorkStealingPool>> pools;
+
+        const int count = resolveThreads(threads);
+        std::lock_guard lock(mutex);
+        auto& pool = pools[count];
+        if (!pool) pool = std::make_unique<WorkStealingPool>(count);
+        return *pool;
+    }
+
+    int availableThreads(const WorkStealingPool* pool, int threads) noexcept {
+        return pool ? pool->size() : resolveThreads(threads);
+    }
+
+    WorkStealingPool& selectPool(WorkStealingPool* pool, int threads) {
+        return pool ? *pool : sharedPool(threads);
+    }
+
+}
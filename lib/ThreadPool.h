@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+namespace Zeta::Parallel {
+
+    /**
+     * @brief Resolves a requested thread count: values <= 0 mean "all hardware threads".
+     */
+    [[nodiscard]]
+    int resolveThreads(int threads) noexcept;
+
+    /**
+     * @brief Fixed-size pool of worker threads with per-worker deques and work stealing.
+     * Each parallelFor call deals its chunk indices out to the workers in contiguous runs;
+     * a worker pops from the back of its own deque and, once empty, steals from the front
+     * of the others. Chunks of very different cost (e.g. Euler-Maclaurin at growing t)
+     * therefore keep every core busy until the last one finishes.
+     */
+    class WorkStealingPool {
+    public:
+        /**
+         * @param threads Number of workers (<= 0: hardware concurrency).
+         */
+        explicit WorkStealingPool(int threads = 0);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        [[nodiscard]]
+        int size() const noexcept { return static_cast<int>(workers.size()); }
+
+        /**
+         * @brief Runs body(chunk, worker) for every chunk in [0, chunks) and waits for all of them.
+         * `worker` is in [0, size()) and identifies the executing thread, e.g. to pick scratch storage.
+         * Calls from different threads are serialized; the body must not call parallelFor on the same pool.
+         */
+        void parallelFor(int chunks, const std::function<void(int chunk, int worker)>& body);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<int> chunks;
+        };
+
+        void workerLoop(int id);
+        bool popOrSteal(int id, int& chunk);
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<Queue>> queues;
+
+        std::mutex submit_mutex;   // one parallelFor at a time
+        std::mutex state_mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        const std::function<void(int, int)>* job = nullptr;
+        std::atomic<int> remaining{0};
+        int active = 0;            // workers currently draining the queues
+        unsigned generation = 0;
+        bool stopping = false;
+    };
+
+    /**
+     * @brief Process-wide pool with the given thread count, created on first use and kept alive.
+     */
+    [[nodiscard]]
+    WorkStealingPool& sharedPool(int threads);
+
+    /**
+     * @brief Workers a caller may use: the size of `pool` if given, resolveThreads(threads) otherwise.
+     */
+    [[nodiscard]]
+    int availableThreads(const WorkStealingPool* pool, int threads) noexcept;
+
+    /**
+     * @brief `pool` if given, sharedPool(threads) otherwise.
+     */
+    [[nodiscard]]
+    WorkStealingPool& selectPool(WorkStealingPool* pool, int threads);
+
+}
@@ -0,0 +1,12 @@
+#include "Zeros.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Zeta::Zeros::detail {
+
+    int turingBlocks(double t) {
+        const double log_t = std::log(std::max(t, 2.0));
+        return std::max(1, static_cast<int>(std::ceil(0.0061 * log_t * log_t + 0.08 * log_t)));
+    }
+
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <concepts>
+#include "HardyZ.h"
+#include "Theta.h"
+
+namespace Zeta {
+
+    /**
+     * @namespace Zeros
+     * @brief Locating the zeros of $ Z(t) $ (the zeros of $ \zeta $ on the critical line).
+     * * Pipeline: a coarse scan through Hardy::computeBlock isolates sign changes,
+     *   each bracket is refined with Brent or Illinois iteration on Hardy::compute,
+     *   and Turing's method (verifyCount) proves that no zero in the interval was missed.
+     */
+    namespace Zeros {
+
+        /**
+         * @brief Root refinement used on each sign-change bracket.
+         */
+        enum class Refinement {
+            /**
+             * @brief Brent's method (inverse quadratic interpolation with bisection fallback).
+             */
+            Brent,
+
+            /**
+             * @brief Illinois variant of regula falsi: one interpolation per step, halving the stale end.
+             */
+            Illinois
+        };
+
+        /**
+         * @brief How scan places its coarse samples.
+         */
+        enum class Sampling {
+            /**
+             * @brief A uniform grid of ScanOptions::samples_per_gap points per mean spacing, in Hardy::computeBlock batches.
+             */
+            Uniform,
+
+            /**
+             * @brief Hardy::sampleAdaptive on each batch window: the same grid, then bisection where $ Z $ bends
+             * or where a zero pair hides between same-signed samples. Close pairs that Uniform steps over
+             * (and verifyCount would have to re-scan for) are bracketed in the first pass.
+             */
+            Adaptive
+        };
+
+        /**
+         * @brief Settings shared by scan and verifyCount.
+         */
+        struct ScanOptions {
+            /**
+             * @brief Algorithm for both the coarse scan and the refinement.
+             * The two must agree, otherwise a bracket's signs need not hold for the refined function.
+             * Method::OdlyzkoSchonhage only evaluates grids: scan adds the Riemann-Siegel remainder to its
+             * blocks, and points are refined with Method::RiemannSiegelRemainder (Hardy::detail::pointwiseMethod).
+             */
+            Method method = Method::RiemannSiegelRemainder;
+
+            /**
+             * @brief Settings passed through to Hardy::compute / Hardy::computeBlock.
+             */
+            Options options = {};
+
+            /**
+             * @brief Coarse samples per mean zero spacing $ 2\pi / \ln(t/2\pi) $.
+             */
+            int samples_per_gap = 4;
+
+            Sampling sampling = Sampling::Uniform;
+
+            /**
+             * @brief For Sampling::Adaptive, the polyline tolerance in units of $ Z $ (Hardy::AdaptiveOptions::tolerance).
+             */
+            double adaptive_tolerance = 0.1;
+
+            /**
+             * @brief Grid points handed to Hardy::computeBlock (or, adaptively, to Hardy::sampleAdaptive) at a time.
+             */
+            int batch = 4096;
+
+            Refinement refinement = Refinement::Brent;
+
+            /**
+             * @brief Absolute width in $ t $ at which a bracket counts as converged.
+             */
+            double tolerance = 1e-10;
+
+            int max_iterations = 100;
+
+            /**
+             * @brief How often verifyCount re-scans a Gram block with doubled density before giving up.
+             */
+            int max_rescans = 4;
+        };
+
+        /**
+         * @brief An interval $ [lo, hi] $ with $ Z(lo) Z(hi) < 0 $.
+         */
+        template <std::floating_point T>
+        struct Bracket {
+            T lo, hi;
+            T z_lo, z_hi;
+        };
+
+        /**
+         * @brief A refined zero of $ Z(t) $.
+         */
+        template <std::floating_point T>
+        struct Zero {
+            T t;
+            int evaluations; ///< Calls to Hardy::compute spent refining this zero
+        };
+
+        /**
+         * @brief Work done by one scan.
+         */
+        struct ScanStats {
+            long long zeros = 0;
+            long long evaluations = 0; ///< All evaluations of $ Z $, coarse and refinement
+        };
+
+        /**
+         * @brief Result of Turing's method on $ [g_a, g_b) $, the Gram points enclosing the request.
+         */
+        template <std::floating_point T>
+        struct TuringCount {
+            long long gram_lo;   ///< $ a $
+            long long gram_hi;   ///< $ b $
+            long long expected;  ///< $ N(g_b) - N(g_a) = b - a $ when confirmed
+            long long found;     ///< Sign changes located in $ [g_a, g_b) $
+            bool confirmed;      ///< Rosser's rule held on all boundary blocks and found == expected
+            std::vector<T> zeros;
+            long long evaluations;
+        };
+
+        // =============================================================
+        // Public API
+        // =============================================================
+
+        /**
+         * @brief Computes the Gram point $ g_n $, the solution of $ \theta(g_n) = n \pi $ with $ g_n > 7 $.
+         * Zeta::thetaInverse of $ n\pi $: starts from $ g_n \approx 2\pi \exp\left(1 + W\left(\frac{n + 1/8}{e}\right)\right) $
+         * and polishes with Newton.
+         * @param n The index (must be >= -1).
+         */
+        template <std::floating_point T>
+        [[nodiscard]]
+        T gramPoint(long long n);
+
+        /**
+         * @brief The consecutive Gram points $ g_{first}, g_{first+1}, \ldots $ (out.size() of them).
+         * Each starts from $ g_{n-1} + \pi / \theta'(g_{n-1}) $ and converges in one or two Newton steps
+         * on a Zeta::ThetaExpansion, so a run costs about one logarithm per expansion block.
+         */
+        template <std::floating_point T>
+        void gramPoints(long long first, std::span<T> out);
+
+        /**
+         * @brief Index of the last Gram point not above t, $ \lfloor \theta(t) / \pi \rfloor $.
+         */
+        template <std::floating_point T>
+        [[nodiscard]]
+        long long gramIndex(T t);
+
+        /**
+         * @brief Finds all sign changes of $ Z $ in $ [start, end] $ and streams each refined zero.
+         * The interval is sampled in batches of ScanOptions::batch points through Hardy::computeBlock
+         * (Hardy::sampleAdaptive for Sampling::Adaptive);
+         * every bracket of a batch is refined and handed to `sink` before the next batch is evaluated,
+         * so zeros arrive in increasing order of $ t $.
+         * @param sink Called as sink(const Zero<T>&) for every zero.
+         */
+        template <std::floating_point T, std::invocable<const Zero<T>&> Sink>
+        ScanStats scan(T start, T end, Sink&& sink, const ScanOptions& options = {});
+
+        /**
+         * @brief Refines a bracket to a single zero.
+         */
+        template <std::floating_point T>
+        [[nodiscard]]
+        Zero<T> refine(const Bracket<T>& bracket, const ScanOptions& options = {});
+
+        /**
+         * @brief Finds the zeros around $ [start, end] $ and proves the count with Turing's method.
+         * The request is widened to good Gram points $ g_a \leq start $, $ g_b > end $
+         * (good: $ (-1)^n Z(g_n) > 0 $). If $ K $ Gram blocks below $ g_a $ and $ K $ above $ g_b $
+         * satisfy Rosser's rule, with
+         * $$ K \geq 0.0061 \ln^2(g_{b+K}) + 0.08 \ln(g_{b+K}) $$
+         * then $ N(g_a) \geq a + 1 $ and $ N(g_b) \leq b + 1 $ (Brent 1979), so $ [g_a, g_b) $ holds at most
+         * $ b - a $ zeros; finding $ b - a $ sign changes confirms all of them, on the critical line.
+         * Blocks short of zeros are re-scanned at doubled density up to ScanOptions::max_rescans times.
+         */
+        template <std::floating_point T>
+        [[nodiscard]]
+        TuringCount<T> verifyCount(T start, T end, const ScanOptions& options = {});
+
+        namespace detail {
+
+            /**
+             * @brief Number of Gram blocks on each side that Turing's method needs at height t.
+             */
+            [[nodiscard]]
+            int turingBlocks(double t);
+
+            template <std::floating_point T>
+            Zero<T> refineBrent(const Bracket<T>& bracket, const ScanOptions& options);
+
+            template <std::floating_point T>
+            Zero<T> refineIllinois(const Bracket<T>& bracket, const ScanOptions& options);
+
+        }
+
+    }
+}
+
+#include "Zeros.tpp"
@@ -0,0 +1,344 @@
+#include <cmath>
+#include <vector>
+#include <array>
+#include <numbers>
+#include <ranges>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+#include <iterator>
+#include "Adaptive.h"
+
+namespace Zeta::Zeros {
+
+    namespace detail {
+
+        template <std::floating_point T>
+        Zero<T> refineBrent(const Bracket<T>& bracket, const ScanOptions& options) {
+            const Method method = Hardy::detail::pointwiseMethod(options.method);
+            auto Z = [&options, method](T t) { return Hardy::compute<T>(t, method, options.options); };
+
+            T a = bracket.lo, b = bracket.hi;
+            T fa = bracket.z_lo, fb = bracket.z_hi;
+            T c = b, fc = fb;
+            T d = b - a, e = d;
+            int evaluations = 0;
+
+            for (int iter = 0; iter < options.max_iterations; ++iter) {
+                if ((fb > T{0}) == (fc > T{0})) {
+                    c = a; fc = fa;
+                    d = e = b - a;
+                }
+                if (std::abs(fc) < std::abs(fb)) {
+                    a = b; b = c; c = a;
+                    fa = fb; fb = fc; fc = fa;
+                }
+
+                const T tol = T{2} * std::numeric_limits<T>::epsilon() * std::abs(b)
+                            + static_cast<T>(0.5 * options.tolerance);
+                const T xm = T{0.5} * (c - b);
+                if (std::abs(xm) <= tol || fb == T{0}) break;
+
+                if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb)) {
+                    // Secant (a == c) or inverse quadratic interpolation
+                    const T s = fb / fa;
+                    T p, q;
+                    if (a == c) {
+                        p = T{2} * xm * s;
+                        q = T{1} - s;
+                    } else {
+                        const T qa = fa / fc;
+                        const T r = fb / fc;
+                        p = s * (T{2} * xm * qa * (qa - r) - (b - a) * (r - T{1}));
+                        q = (qa - T{1}) * (r - T{1}) * (s - T{1});
+                    }
+                    if (p > T{0}) q = -q;
+                    p = std::abs(p);
+
+                    if (T{2} * p < std::min(T{3} * xm * q - std::abs(tol * q), std::abs(e * q))) {
+                        e = d;
+                        d = p / q;
+                    } else {
+                        d = xm; e = d;
+                    }
+                } else {
+                    d = xm; e = d;
+                }
+
+                a = b; fa = fb;
+                b += (std::abs(d) > tol) ? d : std::copysign(tol, xm);
+                fb = Z(b);
+                ++evaluations;
+            }
+
+            return { b, evaluations };
+        }
+
+        template <std::floating_point T>
+        Zero<T> refineIllinois(const Bracket<T>& bracket, const ScanOptions& options) {
+            const Method method = Hardy::detail::pointwiseMethod(options.method);
+            auto Z = [&options, method](T t) { return Hardy::compute<T>(t, method, options.options); };
+
+            T a = bracket.lo, b = bracket.hi;
+            T fa = bracket.z_lo, fb = bracket.z_hi;
+            int evaluations = 0;
+
+            for (int iter = 0; iter < options.max_iterations; ++iter) {
+                if (std::abs(b - a) <= static_cast<T>(options.tolerance)) break;
+
+                const T c = b - fb * (b - a) / (fb - fa);
+                const T fc = Z(c);
+                ++evaluations;
+                if (fc == T{0}) return { c, evaluations };
+
+                if ((fc > T{0}) != (fb > T{0})) {
+                    a = b; fa = fb;
+                } else {
+                    fa *= T{0.5}; // the retained end went stale; halve it so it moves next time
+                }
+                b = c; fb = fc;
+            }
+
+            return { (std::abs(fa) < std::abs(fb)) ? a : b, evaluations };
+        }
+
+    }
+
+    // =====================================================================
+    // Public API Implementation
+    // =====================================================================
+
+    template <std::floating_point T>
+    T gramPoint(long long n) {
+        return Zeta::thetaInverse<T>(static_cast<T>(n) * std::numbers::pi_v<T>);
+    }
+
+    template <std::floating_point T>
+    void gramPoints(long long first, std::span<T> out) {
+        if (out.empty()) return;
+
+        constexpr T PI = std::numbers::pi_v<T>;
+        ThetaExpansion<T> theta;
+
+        // g_{n+1} ~ g_n + pi / theta'(g_n), then Newton; theta and theta' mostly come from the expansion
+        out[0] = gramPoint<T>(first);
+        for (std::size_t i = 1; i < out.size(); ++i) {
+            const T target = static_cast<T>(first + static_cast<long long>(i)) * PI;
+            T t = out[i - 1] + PI / theta.slope(out[i - 1]);
+            for (int iter = 0; iter < 4; ++iter) {
+                const T delta = (theta(t) - target) / theta.slope(t);
+                t -= delta;
+                if (std::abs(delta) <= T{4} * std::numeric_limits<T>::epsilon() * t) break;
+            }
+            out[i] = t;
+        }
+    }
+
+    template <std::floating_point T>
+    long long gramIndex(T t) {
+        return static_cast<long long>(std::floor(Zeta::theta<T>(t) / std::numbers::pi_v<T>));
+    }
+
+    template <std::floating_point T, std::invocable<const Zero<T>&> Sink>
+    ScanStats scan(T start, T end, Sink&& sink, const ScanOptions& options) {
+        ScanStats stats;
+        if (!(end > start)) return stats;
+
+        // One grid for the whole interval, so the batches share their end points and hit `end` exactly
+        const T spacing = Zeta::meanGap<T>(end) / static_cast<T>(std::max(options.samples_per_gap, 1));
+        const long long total = static_cast<long long>(std::ceil((end - start) / spacing)) + 1;
+        const T step = (end - start) / static_cast<T>(total - 1);
+        const long long batch = std::max(options.batch, 2);
+
+        T t_prev = start;
+        T z_prev = T{0};
+        bool have_prev = false;
+
+        // Brackets the sign change (if any) between the previous sample and this one
+        auto visit = [&](T t, T z) {
+            if (z == T{0}) {
+                sink(Zero<T>{ t, 0 });
+                ++stats.zeros;
+            } else if (have_prev && z_prev != T{0} && (z > T{0}) != (z_prev > T{0})) {
+                const Zero<T> zero = refine<T>(Bracket<T>{ t_prev, t, z_prev, z }, options);
+                stats.evaluations += zero.evaluations;
+                sink(zero);
+                ++stats.zeros;
+            }
+
+            t_prev = t;
+            z_prev = z;
+            have_prev = true;
+        };
+
+        if (options.sampling == Sampling::Adaptive) {
+            // sampleAdaptive completes Odlyzko-Schonhage grids with the remainder, so the signs are the refinement's
+            Hardy::AdaptiveOptions adaptive;
+            adaptive.method = options.method;
+            adaptive.options = options.options;
+            adaptive.curve = Hardy::AdaptiveOptions::Curve::Hardy;
+            adaptive.tolerance = options.adaptive_tolerance;
+            adaptive.samples_per_gap = options.samples_per_gap;
+            adaptive.max_evaluations = static_cast<int>(std::min<long long>(4 * batch, std::numeric_limits<int>::max()));
+
+            // Windows of the uniform batches, sharing their end points
+            for (long long first = 0; first < total; first += batch - 1) {
+                const long long last = std::min(first + batch, total); // exclusive
+                const T lo = start + static_cast<T>(first) * step;
+                const T hi = (last == total) ? end : start + static_cast<T>(last - 1) * step;
+
+                const Hardy::Samples<T> samples = Hardy::sampleAdaptive<T>(lo, hi, adaptive);
+                const std::size_t skip = have_prev ? 1 : 0;
+                stats.evaluations += static_cast<long long>(samples.t.size() - skip);
+                for (std::size_t k = skip; k < samples.t.size(); ++k) visit(samples.t[k], samples.z[k]);
+
+                if (last == total) break;
+            }
+            return stats;
+        }
+
+        for (long long first = 0; first < total; first += batch - 1) {
+            const long long last = std::min(first + batch, total); // exclusive
+            const int points = static_cast<int>(last - first);
+            const T t_first = start + static_cast<T>(first) * step;
+
+            std::vector<T> values = Hardy::computeBlock<T>(
+                t_first, static_cast<T>(points - 1) * step, points, options.method, options.options);
+            stats.evaluations += points;
+
+            // The block is the main sum only; with the remainder its signs match the refinement's
+            if (options.method == Method::OdlyzkoSchonhage) {
+                Hardy::detail::addRemainderRS<T>(t_first, step, values, options.options.rs_order);
+            }
+
+            // The first point of a batch repeats the last one of the previous batch
+            for (int k = have_prev ? 1 : 0; k < points; ++k) visit(t_first + static_cast<T>(k) * step, values[k]);
+
+            if (last == total) break;
+        }
+
+        return stats;
+    }
+
+    template <std::floating_point T>
+    Zero<T> refine(const Bracket<T>& bracket, const ScanOptions& options) {
+        switch (options.refinement) {
+            case Refinement::Illinois:
+                return detail::refineIllinois<T>(bracket, options);
+            case Refinement::Brent:
+            default:
+                return detail::refineBrent<T>(bracket, options);
+        }
+    }
+
+    template <std::floating_point T>
+    TuringCount<T> verifyCount(T start, T end, const ScanOptions& options) {
+        TuringCount<T> result{ 0, 0, 0, 0, false, {}, 0 };
+        const Method pointwise = Hardy::detail::pointwiseMethod(options.method);
+
+        constexpr long long FIRST_GRAM = -1;
+
+        // Gram points with their Z values, evaluated once. The walks below mostly step to n + 1
+        // or n - 1, so the points themselves are generated a batch at a time in the walk's direction.
+        constexpr int GRAM_BATCH = 16;
+        std::map<long long, std::pair<T, T>> gram;
+        std::map<long long, T> gram_t;
+        auto gramAt = [&](long long n, int direction = 1) -> const std::pair<T, T>& {
+            auto it = gram.find(n);
+            if (it == gram.end()) {
+                auto t_it = gram_t.find(n);
+                if (t_it == gram_t.end()) {
+                    const long long first = (direction < 0) ? std::max(n - GRAM_BATCH + 1, FIRST_GRAM) : n;
+                    std::array<T, GRAM_BATCH> batch;
+                    gramPoints<T>(first, batch);
+                    for (int i = 0; i < GRAM_BATCH; ++i) gram_t.emplace(first + i, batch[i]);
+                    t_it = gram_t.find(n);
+                }
+                const T g = t_it->second;
+                it = gram.emplace(n, std::pair{ g, Hardy::compute<T>(g, pointwise, options.options) }).first;
+                ++result.evaluations;
+            }
+            return it->second;
+        };
+        auto good = [&](long long n, int direction = 1) {
+            const T z = gramAt(n, direction).second;
+            return (n % 2 == 0) ? z > T{0} : z < T{0};
+        };
+
+        // Good Gram points a <= start and b > end
+        long long a = std::max(gramIndex<T>(start), FIRST_GRAM);
+        while (a > FIRST_GRAM && !good(a, -1)) --a;
+        long long b = std::max(gramIndex<T>(end) + 1, FIRST_GRAM);
+        while (!good(b)) ++b;
+
+        // K blocks each side; K depends on the height of the last block, so grow until consistent
+        std::vector<long long> below{ a }; // good points a, a_1, ..., a_K (descending)
+        std::vector<long long> above{ b }; // good points b, b_1, ..., b_K (ascending)
+        int K = 1;
+        while (true) {
+            while (static_cast<int>(above.size()) <= K) {
+                long long n = above.back() + 1;
+                while (!good(n)) ++n;
+                above.push_back(n);
+            }
+            while (static_cast<int>(below.size()) <= K && below.back() > FIRST_GRAM) {
+                long long n = below.back() - 1;
+                while (n > FIRST_GRAM && !good(n, -1)) --n;
+                if (!good(n, -1)) break;
+                below.push_back(n);
+            }
+            const int needed = detail::turingBlocks(static_cast<double>(gramAt(above[K]).first));
+            if (needed <= K) break;
+            K = needed;
+        }
+        const bool enough_below = static_cast<int>(below.size()) > K;
+
+        result.gram_lo = a;
+        result.gram_hi = b;
+        result.expected = b - a;
+
+        // Coarse scan of the whole window, then per-region counts
+        const long long lo_index = below[std::min<std::size_t>(K, below.size() - 1)];
+        const long long hi_index = above[K];
+        std::vector<T> zeros;
+        result.evaluations += scan<T>(gramAt(lo_index).first, gramAt(hi_index).first,
+                                      [&zeros](const Zero<T>& z) { zeros.push_back(z.t); }, options).evaluations;
+
+        auto countIn = [&zeros](T lo, T hi) {
+            return std::ranges::count_if(zeros, [lo, hi](T t) { return t >= lo && t < hi; });
+        };
+
+        // Re-scans [g_j, g_k) until it holds k - j zeros; true if Rosser's rule is satisfied
+        auto settle = [&](long long j, long long k) {
+            const T lo = gramAt(j).first;
+            const T hi = gramAt(k).first;
+            ScanOptions finer = options;
+            for (int pass = 0; countIn(lo, hi) < k - j; ++pass) {
+                if (pass == options.max_rescans) return false;
+                finer.samples_per_gap *= 2;
+                std::vector<T> block;
+                result.evaluations += scan<T>(lo, hi, [&block](const Zero<T>& z) { block.push_back(z.t); },
+                                              finer).evaluations;
+                std::erase_if(zeros, [lo, hi](T t) { return t >= lo && t < hi; });
+                std::ranges::copy_if(block, std::back_inserter(zeros), [lo, hi](T t) { return t >= lo && t < hi; });
+            }
+            return true;
+        };
+
+        bool rosser = enough_below;
+        for (std::size_t i = 0; i + 1 < below.size(); ++i) rosser = settle(below[i + 1], below[i]) && rosser;
+        for (std::size_t i = 0; i + 1 < above.size(); ++i) rosser = settle(above[i], above[i + 1]) && rosser;
+        settle(a, b);
+
+        std::ranges::sort(zeros);
+        const T g_a = gramAt(a).first;
+        const T g_b = gramAt(b).first;
+        std::ranges::copy_if(zeros, std::back_inserter(result.zeros), [g_a, g_b](T t) { return t >= g_a && t < g_b; });
+
+        result.found = static_cast<long long>(result.zeros.size());
+        result.confirmed = rosser && result.found == result.expected;
+        return result;
+    }
+
+}
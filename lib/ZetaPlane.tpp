@@ -0,0 +1,134 @@
+#include "Dirichlet.h"
+#include "ThreadPool.h"
+#include "Profile.h"
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+#include <ranges>
+
+namespace Zeta::Plane {
+
+    template <std::floating_point T>
+    std::complex<T> gridPoint(const Region<T>& region, int columns, int rows, int column, int row) noexcept {
+        const T sigma_step = (columns > 1) ? (region.sigma_max - region.sigma_min) / static_cast<T>(columns - 1) : T{0};
+        const T t_step = (rows > 1) ? (region.t_max - region.t_min) / static_cast<T>(rows - 1) : T{0};
+        return { region.sigma_min + static_cast<T>(column) * sigma_step,
+                 region.t_max - static_cast<T>(row) * t_step };
+    }
+
+    template <std::floating_point T>
+    void evaluateTile(const Region<T>& region, int columns, int rows, const Tile& tile,
+                      std::span<std::complex<T>> out, double tolerance) {
+        const int w = tile.column1 - tile.column0;
+        const int h = tile.row1 - tile.row0;
+        if (w <= 0 || h <= 0) return;
+
+        ZETA_COUNT(Evaluations, w * h);
+
+        const std::complex<T> top_left = gridPoint(region, columns, rows, tile.column0, tile.row0);
+        const std::complex<T> bottom_right = gridPoint(region, columns, rows, tile.column1 - 1, tile.row1 - 1);
+        const T t_abs = std::max(std::abs(top_left.imag()), std::abs(bottom_right.imag()));
+        const T t_min_abs = ((top_left.imag() > T{0}) != (bottom_right.imag() > T{0}))
+                          ? T{0} : std::min(std::abs(top_left.imag()), std::abs(bottom_right.imag()));
+
+        // Left of the critical line |zeta(s)| = |chi(s)| |zeta(1 - s)| grows like (|t| / 2 pi)^{1/2 - sigma},
+        // and so does the rounding error of the sum; the tolerance is relative to that scale there
+        auto edgeTolerance = [tolerance, t_min_abs](T sigma) {
+            if (!(sigma < T{0.5})) return tolerance;
+            const double scale = std::pow(static_cast<double>(t_min_abs) / (2.0 * std::numbers::pi), 0.5 - static_cast<double>(sigma));
+            return tolerance * std::max(scale, 1.0);
+        };
+
+        // The remainder bound grows with |t|; in sigma it can move either way, so both edges are tried
+        const Hardy::detail::EMParams left = Hardy::detail::chooseEM(std::complex<T>(top_left.real(), t_abs),
+                                                                     edgeTolerance(top_left.real()));
+        const Hardy::detail::EMParams right = Hardy::detail::chooseEM(std::complex<T>(bottom_right.real(), t_abs),
+                                                                      edgeTolerance(bottom_right.real()));
+        const int N = std::max(left.N, right.N);
+        const int m = std::max(left.m, right.m);
+
+        const DirichletTable<T>& table = Zeta::dirichletTable<T>(N);
+        ZETA_COUNT(TranscendentalCalls, N * (w + h));
+
+        // Column table n^{-sigma_j}, n-major so the inner loop below runs over contiguous j
+        std::vector<T> pow_sigma(static_cast<std::size_t>(N) * w);
+        for (int j = 0; j < w; ++j) {
+            const T sigma = gridPoint(region, columns, rows, tile.column0 + j, tile.row0).real();
+            for (int n = 0; n < N; ++n) pow_sigma[static_cast<std::size_t>(n) * w + j] = std::exp(-sigma * table.log_n[n]);
+        }
+
+        // Row table e^{-i t_i ln n}
+        std::vector<T> row_cos(N), row_sin(N);
+        std::vector<T> sum_re(w), sum_im(w);
+
+        for (int i = 0; i < h; ++i) {
+            const T t = gridPoint(region, columns, rows, tile.column0, tile.row0 + i).imag();
+            const bool precise = std::same_as<T, double> && std::abs(t) >= static_cast<T>(Hardy::detail::PRECISE_PHASE_MIN_T);
+            for (int n = 0; n < N; ++n) {
+                T phase = -t * table.log_n[n];
+                if constexpr (std::same_as<T, double>) {
+                    if (precise) phase = Zeta::reduceTwoPi(-(DoubleDouble(table.log_n[n], table.log_n_lo[n]) * t));
+                }
+                row_cos[n] = std::cos(phase);
+                row_sin[n] = std::sin(phase);
+            }
+
+            std::ranges::fill(sum_re, T{0});
+            std::ranges::fill(sum_im, T{0});
+            {
+                ZETA_TIMED(DirichletSum);
+                ZETA_COUNT(TermsSummed, (N - 1) * w);
+                for (int n = 0; n < N - 1; ++n) {
+                    const T* weights = pow_sigma.data() + static_cast<std::size_t>(n) * w;
+                    const T c = row_cos[n];
+                    const T s = row_sin[n];
+                    for (int j = 0; j < w; ++j) {
+                        sum_re[j] += weights[j] * c;
+                        sum_im[j] += weights[j] * s;
+                    }
+                }
+            }
+
+            const T* last = pow_sigma.data() + static_cast<std::size_t>(N - 1) * w;
+            for (int j = 0; j < w; ++j) {
+                const std::complex<T> s = gridPoint(region, columns, rows, tile.column0 + j, tile.row0 + i);
+                const std::complex<T> N_pow_minus_s(last[j] * row_cos[N - 1], last[j] * row_sin[N - 1]);
+                out[static_cast<std::size_t>(i) * w + j] =
+                    std::complex<T>(sum_re[j], sum_im[j]) + Hardy::detail::tailEM(s, N, m, N_pow_minus_s);
+            }
+        }
+    }
+
+    template <std::floating_point T>
+    std::vector<std::complex<T>> evaluate(const Region<T>& region, int columns, int rows, const Options& options) {
+        if (columns <= 0 || rows <= 0) return {};
+
+        std::vector<std::complex<T>> values(static_cast<std::size_t>(columns) * rows);
+        const int tiles_x = (columns + TILE_SIZE - 1) / TILE_SIZE;
+        const int tiles_y = (rows + TILE_SIZE - 1) / TILE_SIZE;
+        const int tiles = tiles_x * tiles_y;
+        const int threads = Parallel::availableThreads(options.pool, options.threads);
+
+        auto run_tile = [&](int index) {
+            const Tile tile{ (index % tiles_x) * TILE_SIZE, (index / tiles_x) * TILE_SIZE,
+                             std::min((index % tiles_x + 1) * TILE_SIZE, columns),
+                             std::min((index / tiles_x + 1) * TILE_SIZE, rows) };
+            const int w = tile.column1 - tile.column0;
+            std::vector<std::complex<T>> block(static_cast<std::size_t>(w) * (tile.row1 - tile.row0));
+            evaluateTile<T>(region, columns, rows, tile, block, options.em_tolerance);
+            for (int row = tile.row0; row < tile.row1; ++row) {
+                std::ranges::copy_n(block.begin() + static_cast<std::ptrdiff_t>(row - tile.row0) * w, w,
+                                    values.begin() + static_cast<std::ptrdiff_t>(row) * columns + tile.column0);
+            }
+        };
+
+        // The pool is keyed by the budget, not by the tile count, so image sizes do not each keep a pool alive
+        if (threads <= 1 || tiles <= 1) {
+            std::ranges::for_each(std::views::iota(0, tiles), run_tile);
+        } else {
+            Parallel::selectPool(options.pool, threads).parallelFor(tiles, [&](int index, int) { run_tile(index); });
+        }
+        return values;
+    }
+
+}
@@ -0,0 +1,39 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <filesystem>
+#include <unistd.h>
+#include "DeltaFrames.h"
+
+// Expands a delta frame file (.pdl) into PPM frames or a Y4M stream.
+//   delta_expand in.pdl out_folder     -> out_folder/frame_%04d.ppm
+//   delta_expand in.pdl out.y4m        -> one Y4M file
+//   delta_expand in.pdl -              -> Y4M on stdout, e.g. | ffplay -  or | ffmpeg -i - out.mp4
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <in.pdl> <out_folder | out.y4m | ->" << std::endl;
+        return 1;
+    }
+
+    DeltaReader reader(argv[1]);
+    if (!reader.ok()) return 1;
+
+    const std::string target = argv[2];
+    const bool is_y4m = target.size() > 4 && target.compare(target.size() - 4, 4, ".y4m") == 0;
+
+    std::unique_ptr<FrameSink> sink;
+    if (target == "-") {
+        sink = StreamSink::to_fd(dup(STDOUT_FILENO), StreamSink::Format::Y4M, reader.fps());
+    } else if (is_y4m) {
+        sink = StreamSink::to_file(target, StreamSink::Format::Y4M, reader.fps());
+    } else {
+        std::error_code ec;
+        std::filesystem::create_directories(target, ec);
+        if (ec) { std::cerr << "Error creating " << target << ": " << ec.message() << std::endl; return 1; }
+        sink = std::make_unique<PpmFileSink>(target);
+    }
+
+    reader.expand(*sink);
+    std::cerr << "Expanded " << reader.frames() << " frames (" << reader.width() << "x" << reader.height() << ")" << std::endl;
+    return 0;
+}
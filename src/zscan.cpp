@@ -0,0 +1,192 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Shards.h"
+
+// Sharded, resumable Z(t) scans (see lib/Shards.h).
+//   zscan run t0 t1 points dir [options]     all shards as local processes, then dir/scan.zsc
+//   zscan run t0 t1 points dir --shard i     one shard only, e.g. one per node on a shared filesystem
+//   zscan merge out.zsc shard.zsc...         check and concatenate shards
+//   zscan verify shard.zsc...                check only
+//   zscan info file.zsc                      header and progress
+// Options: --method em|rs|rsr|os  --shards S  --jobs P  --threads N  --checkpoint CHUNKS
+//          --precision float|double|long  --theta
+// Rerunning an interrupted `run` with the same arguments continues every shard from its last commit.
+namespace {
+
+    struct Arguments {
+        std::string t0, t1;
+        std::int64_t points = 0;
+        std::string directory;
+        Zeta::Method method = Zeta::Method::RiemannSiegelRemainder;
+        std::string precision = "double";
+        int shards = 1;
+        int shard = -1;
+        int jobs = 0;
+        int threads = 1;
+        int checkpoint = 16;
+        bool theta = false;
+    };
+
+    bool parse_method(const std::string& name, Zeta::Method& method) {
+        if (name == "em") method = Zeta::Method::EulerMaclaurin;
+        else if (name == "rs") method = Zeta::Method::RiemannSiegel;
+        else if (name == "rsr") method = Zeta::Method::RiemannSiegelRemainder;
+        else if (name == "os") method = Zeta::Method::OdlyzkoSchonhage;
+        else return false;
+        return true;
+    }
+
+    const char* method_name(Zeta::Method method) {
+        switch (method) {
+            case Zeta::Method::EulerMaclaurin: return "em";
+            case Zeta::Method::RiemannSiegel: return "rs";
+            case Zeta::Method::RiemannSiegelRemainder: return "rsr";
+            default: return "os";
+        }
+    }
+
+    template <std::floating_point T>
+    T parse_value(const std::string& text) {
+        return static_cast<T>(std::stold(text));
+    }
+
+    template <std::floating_point T>
+    bool run_shard(const Arguments& args, int shard) {
+        Zeta::Shards::Job<T> job{ parse_value<T>(args.t0), parse_value<T>(args.t1), args.points, args.method };
+        job.options.threads = args.threads;
+        job.shards = args.shards;
+        job.store_theta = args.theta;
+        job.checkpoint_chunks = args.checkpoint;
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool complete = Zeta::Shards::runShard(job, shard, Zeta::Shards::shardPath(args.directory, shard));
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const Zeta::Shards::Range range = Zeta::Shards::shardRange(args.points, args.method, args.shards, shard);
+        std::cerr << "Shard " << shard << " [" << range.first << ", " << range.last << "): "
+                  << (complete ? "complete" : "failed") << " after " << seconds << " s" << std::endl;
+        return complete;
+    }
+
+    bool run_shard(const Arguments& args, int shard) {
+        if (args.precision == "float") return run_shard<float>(args, shard);
+        if (args.precision == "long") return run_shard<long double>(args, shard);
+        return run_shard<double>(args, shard);
+    }
+
+    // Forks one process per shard, at most `jobs` at a time
+    bool run_local(const Arguments& args) {
+        const int jobs = args.jobs > 0 ? args.jobs : std::max(1, static_cast<int>(::sysconf(_SC_NPROCESSORS_ONLN)));
+        int next = 0;
+        int running = 0;
+        bool ok = true;
+
+        while (next < args.shards || running > 0) {
+            if (next < args.shards && running < jobs) {
+                const pid_t pid = ::fork();
+                if (pid == 0) std::_Exit(run_shard(args, next) ? 0 : 1);
+                if (pid < 0) { std::cerr << "fork failed" << std::endl; return false; }
+                ++next;
+                ++running;
+                continue;
+            }
+            int status = 0;
+            if (::wait(&status) < 0) break;
+            --running;
+            ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        return ok;
+    }
+
+    int usage(const char* name) {
+        std::cerr << "Usage: " << name << " run <t0> <t1> <points> <dir> [--method em|rs|rsr|os] [--shards S]\n"
+                  << "           [--shard i | --jobs P] [--threads N] [--checkpoint CHUNKS] [--precision float|double|long] [--theta]\n"
+                  << "       " << name << " merge <out.zsc> <shard.zsc>...\n"
+                  << "       " << name << " verify <shard.zsc>...\n"
+                  << "       " << name << " info <file.zsc>" << std::endl;
+        return 1;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage(argv[0]);
+    const std::string command = argv[1];
+
+    if (command == "merge" || command == "verify") {
+        const bool write = command == "merge";
+        if (write && argc < 4) return usage(argv[0]);
+        const std::vector<std::string> inputs(argv + (write ? 3 : 2), argv + argc);
+        const bool ok = Zeta::Shards::merge(inputs, write ? argv[2] : "");
+        std::cerr << (ok ? (write ? "Merged into " + std::string(argv[2]) : "Shards are consistent") : "Failed") << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    if (command == "info") {
+        Zeta::Shards::ScanFile file(argv[2]);
+        if (!file.ok()) return 1;
+        const Zeta::Shards::Header& h = file.header();
+        std::cout << "method " << method_name(h.method) << ", " << h.value_size << "-byte values"
+                  << (h.has_theta ? ", with theta" : "") << "\n"
+                  << "grid t0 = " << h.start_t << ", step = " << h.step << ", " << h.points << " points\n"
+                  << "shard " << h.shard << " of " << h.shards << ": points [" << h.first << ", " << h.first + h.count
+                  << "), " << h.done << " committed" << std::endl;
+        return 0;
+    }
+
+    if (command != "run" || argc < 6) return usage(argv[0]);
+
+    Arguments args;
+    args.t0 = argv[2];
+    args.t1 = argv[3];
+    args.directory = argv[5];
+    try {
+        args.points = std::stoll(argv[4]);
+        for (int i = 6; i < argc; ++i) {
+            const std::string flag = argv[i];
+            const bool has_value = i + 1 < argc;
+            if (flag == "--theta") args.theta = true;
+            else if (flag == "--method" && has_value) { if (!parse_method(argv[++i], args.method)) return usage(argv[0]); }
+            else if (flag == "--precision" && has_value) args.precision = argv[++i];
+            else if (flag == "--shards" && has_value) args.shards = std::stoi(argv[++i]);
+            else if (flag == "--shard" && has_value) args.shard = std::stoi(argv[++i]);
+            else if (flag == "--jobs" && has_value) args.jobs = std::stoi(argv[++i]);
+            else if (flag == "--threads" && has_value) args.threads = std::stoi(argv[++i]);
+            else if (flag == "--checkpoint" && has_value) args.checkpoint = std::stoi(argv[++i]);
+            else return usage(argv[0]);
+        }
+    } catch (const std::exception&) {
+        return usage(argv[0]);
+    }
+    if (args.points <= 0 || args.shards <= 0 || args.shard < -1 || args.shard >= args.shards || args.checkpoint <= 0) {
+        return usage(argv[0]);
+    }
+
+    ::mkdir(args.directory.c_str(), 0755);
+
+    if (args.shard >= 0) return run_shard(args, args.shard) ? 0 : 1;
+
+    if (!run_local(args)) {
+        std::cerr << "Some shards failed; rerun the same command to resume them" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> inputs;
+    for (int i = 0; i < args.shards; ++i) inputs.push_back(Zeta::Shards::shardPath(args.directory, i));
+    const std::string output = args.directory + "/scan.zsc";
+    if (!Zeta::Shards::merge(inputs, output)) {
+        std::cerr << "Could not merge the shards of " << args.directory << " into " << output << std::endl;
+        return 1;
+    }
+    std::cerr << "Merged into " << output << std::endl;
+    return 0;
+}